@@ -159,8 +159,10 @@ namespace SharpProj.CrsExplorer
 
             try
             {
-                using (var ct = CoordinateTransform.Create(crs.GeodeticCRS.WithNormalizedAxis(), crs))
+                using (var exact = CoordinateTransform.Create(crs.GeodeticCRS.WithNormalizedAxis(), crs))
+                using (var approximation = CreateApproximation(exact, crs))
                 {
+                    var ct = (CoordinateTransform)approximation ?? exact;
                     _crs = crs;
                     foreach (var countryGeo in want.Select(x => x.Geometry))
                     {
@@ -240,6 +242,29 @@ namespace SharpProj.CrsExplorer
             }
         }
 
+        // Drawing doesn't need exact coordinates, so interpolate within a fraction of the map size over the area of use
+        private static ApproximateCoordinateTransform CreateApproximation(CoordinateTransform ct, CoordinateReferenceSystem crs)
+        {
+            var ua = crs.UsageArea;
+
+            if (!(ua.WestLongitude < ua.EastLongitude && ua.SouthLatitude < ua.NorthLatitude))
+                return null;
+
+            double maxError = Math.Max(ua.MaxX - ua.MinX, ua.MaxY - ua.MinY) / 4096;
+
+            if (!(maxError > 0))
+                return null;
+
+            try
+            {
+                return ct.CreateApproximation(ua.WestLongitude, ua.SouthLatitude, ua.EastLongitude, ua.NorthLatitude, maxError);
+            }
+            catch (ProjException)
+            {
+                return null;
+            }
+        }
+
         private IEnumerable<(double, double)> NormalizeLongitude(double westLongitude, double eastLongitude)
         {
             if (westLongitude < eastLongitude)
@@ -20,10 +20,21 @@ namespace SharpProj.NTS
         /// </summary>
         public int SRID { get; }
 
+        volatile CoordinateReferenceSystem _crs;
+
         /// <summary>
         /// The registered CoordinateReferenceSystem
         /// </summary>
-        public CoordinateReferenceSystem CRS { get; }
+        public CoordinateReferenceSystem CRS => _crs ?? EnsureCRS();
+
+        /// <summary>
+        /// Gets a boolean indicating whether the <see cref="CRS"/> is already created. Items loaded via
+        /// <see cref="SridRegister.LoadSnapshot"/> create their CRS on first use.
+        /// </summary>
+        public bool IsCRSCreated => _crs != null;
+
+        internal SridSnapshotItem Snapshot { get; }
+        internal PrecisionModel PrecisionModel { get; }
 
         readonly List<object> _idMap = new List<object>();
 
@@ -80,12 +91,40 @@ namespace SharpProj.NTS
                 throw new ArgumentNullException(nameof(crs));
 
             SRID = srid;
-            CRS = crs;
-            PrecisionModel pm = args.PrecisionModel;
+            _crs = crs;
+            PrecisionModel = args.PrecisionModel;
 
-            _factory = new Lazy<GeometryFactory>(() => NtsGeometryServices.CreateGeometryFactory(
-                pm ?? NtsGeometryServices.DefaultPrecisionModel,
-                SRID));
+            _factory = new Lazy<GeometryFactory>(CreateFactory);
+        }
+
+        internal SridItem(SridSnapshotItem snapshot, int srid, PrecisionModel precisionModel)
+        {
+            if (snapshot is null)
+                throw new ArgumentNullException(nameof(snapshot));
+
+            SRID = srid;
+            Snapshot = snapshot;
+            PrecisionModel = precisionModel;
+
+            _factory = new Lazy<GeometryFactory>(CreateFactory);
+        }
+
+        CoordinateReferenceSystem EnsureCRS()
+        {
+            lock (Snapshot)
+            {
+                if (_crs == null)
+                    _crs = SridRegister.CreateFromSnapshot(this);
+
+                return _crs;
+            }
+        }
+
+        GeometryFactory CreateFactory()
+        {
+            return NtsGeometryServices.CreateGeometryFactory(
+                PrecisionModel ?? NtsGeometryServices.DefaultPrecisionModel,
+                SRID);
         }
 
         static Lazy<NtsGeometryServices> _ntsGeometryServices = new Lazy<NtsGeometryServices>(SetupServices);
@@ -154,6 +193,16 @@ namespace SharpProj.NTS
                 throw new InvalidOperationException();
         }
 
+        // Called within lock from SridRegister
+        internal IEnumerable<object> GetIds()
+        {
+            foreach (object v in _idMap)
+            {
+                if (v != null)
+                    yield return v;
+            }
+        }
+
         // Called within writelock from SridRegister
         internal void SetId(int n, object value)
         {
@@ -0,0 +1,320 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+using NetTopologySuite.Geometries;
+using SharpProj.Implementation;
+using SharpProj.Proj;
+
+namespace SharpProj.NTS
+{
+    /// <summary>
+    /// Definition of a <see cref="SridItem"/> as stored in a snapshot, to allow creating its CRS on first use
+    /// </summary>
+    internal sealed class SridSnapshotItem
+    {
+        public string ProjJson { get; set; }
+        public string Name { get; set; }
+        public Identifier[] Identifiers { get; set; }
+        /// <summary>West, south, east, north. Or null when no usage area is known</summary>
+        public double[] UsageArea { get; set; }
+        public string UsageAreaName { get; set; }
+        /// <summary>Fingerprint of the CRS, or empty when the snapshot was written by another PROJ version</summary>
+        public ProjFingerprint Fingerprint { get; set; }
+
+        public static SridSnapshotItem FromCRS(CoordinateReferenceSystem crs)
+        {
+            var ua = crs.UsageArea;
+
+            return new SridSnapshotItem
+            {
+                ProjJson = crs.AsProjJson(),
+                Name = crs.Name,
+                Identifiers = crs.Identifiers?.ToArray() ?? new Identifier[0],
+                UsageArea = (ua != null) ? new[] { ua.WestLongitude, ua.SouthLatitude, ua.EastLongitude, ua.NorthLatitude } : null,
+                UsageAreaName = ua?.Name,
+                Fingerprint = crs.Fingerprint
+            };
+        }
+
+        // Cheap check whether the item can describe crs, before creating the item's CRS
+        public bool MightMatch(CoordinateReferenceSystem crs)
+        {
+            if (Identifiers.Length > 0 && crs.Identifiers?.Any(x => Identifiers.Contains(x)) == true)
+                return true;
+
+            return string.Equals(Name, crs.Name, StringComparison.Ordinal);
+        }
+    }
+
+    partial class SridRegister
+    {
+        const int SnapshotMagic = 0x52535053; // "SPSR"
+        const int SnapshotVersion = 2;
+
+        static readonly List<SridItem> _snapshotItems = new List<SridItem>();
+        static readonly ConcurrentDictionary<CoordinateReferenceSystem, SridItem> _created = new ConcurrentDictionary<CoordinateReferenceSystem, SridItem>();
+
+        /// <summary>
+        /// Writes all registered <see cref="SridItem"/>s, with their definitions and registered enum ids, to a compact binary snapshot
+        /// that can be loaded with <see cref="LoadSnapshot"/> on a later start, without creating every CRS from the database.
+        /// </summary>
+        /// <param name="stream"></param>
+        public static void SaveSnapshot(Stream stream)
+        {
+            if (stream == null)
+                throw new ArgumentNullException(nameof(stream));
+
+            List<SridItem> items;
+            using (_rwl.WithReadLock())
+            {
+                items = _catalog.Values.OrderBy(x => x.SRID).ToList();
+            }
+
+            var entries = new List<SnapshotEntry>(items.Count);
+            foreach (SridItem item in items)
+            {
+                SridSnapshotItem si = item.Snapshot ?? SridSnapshotItem.FromCRS(item.CRS);
+                List<object> ids;
+
+                using (_rwl.WithReadLock())
+                {
+                    ids = item.GetIds().ToList();
+                }
+
+                entries.Add(new SnapshotEntry
+                {
+                    Srid = item.SRID,
+                    Item = si,
+                    Fingerprint = si.Fingerprint.IsEmpty ? item.CRS.Fingerprint : si.Fingerprint,
+                    PrecisionModel = item.PrecisionModel,
+                    Ids = ids
+                });
+            }
+
+            WriteSnapshot(stream, entries);
+        }
+
+        /// <summary>
+        /// Writes a snapshot of <paramref name="crss"/> with the specified SRIDs, without registering them. Allows preparing a
+        /// snapshot for <see cref="LoadSnapshot"/> outside the process that will use it.
+        /// </summary>
+        /// <param name="stream"></param>
+        /// <param name="crss">SRID and CRS of each item</param>
+        public static void SaveSnapshot(Stream stream, IEnumerable<KeyValuePair<int, CoordinateReferenceSystem>> crss)
+        {
+            if (stream == null)
+                throw new ArgumentNullException(nameof(stream));
+            else if (crss == null)
+                throw new ArgumentNullException(nameof(crss));
+
+            var entries = new List<SnapshotEntry>();
+            foreach (var kv in crss)
+            {
+                if (kv.Value == null)
+                    throw new ArgumentNullException(nameof(crss));
+
+                var si = SridSnapshotItem.FromCRS(kv.Value);
+                entries.Add(new SnapshotEntry { Srid = kv.Key, Item = si, Fingerprint = si.Fingerprint, Ids = new List<object>() });
+            }
+
+            WriteSnapshot(stream, entries);
+        }
+
+        static void WriteSnapshot(Stream stream, List<SnapshotEntry> entries)
+        {
+            using (var w = new BinaryWriter(stream, Encoding.UTF8, true))
+            {
+                w.Write(SnapshotMagic);
+                w.Write(SnapshotVersion);
+                w.Write(ProjContext.ProjVersion.ToString()); // Fingerprints are only stable within a PROJ version
+                w.Write(entries.Count);
+
+                foreach (SnapshotEntry e in entries)
+                {
+                    SridSnapshotItem si = e.Item;
+
+                    w.Write(e.Srid);
+                    w.Write(si.ProjJson);
+                    WriteNullable(w, si.Name);
+
+                    w.Write(si.Identifiers.Length);
+                    foreach (Identifier id in si.Identifiers)
+                    {
+                        w.Write(id.Authority);
+                        w.Write(id.Code);
+                    }
+
+                    w.Write(si.UsageArea != null);
+                    if (si.UsageArea != null)
+                    {
+                        foreach (double d in si.UsageArea)
+                            w.Write(d);
+                        WriteNullable(w, si.UsageAreaName);
+                    }
+
+                    w.Write(e.Fingerprint.High);
+                    w.Write(e.Fingerprint.Low);
+
+                    PrecisionModel pm = e.PrecisionModel;
+                    w.Write(pm != null);
+                    if (pm != null)
+                    {
+                        w.Write((int)pm.PrecisionModelType);
+                        w.Write(pm.Scale);
+                    }
+
+                    w.Write(e.Ids.Count);
+                    foreach (object id in e.Ids)
+                    {
+                        Type t = id.GetType();
+                        w.Write(t.FullName + ", " + t.Assembly.GetName().Name);
+                        w.Write(Convert.ToInt64(id));
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Registers the <see cref="SridItem"/>s from a snapshot created by <see cref="SaveSnapshot(Stream)"/>. The CRS of each item is
+        /// only created when it is first used. Items with an SRID or id that is already registered are skipped.
+        /// </summary>
+        /// <param name="stream"></param>
+        /// <returns>The number of items registered</returns>
+        /// <exception cref="InvalidDataException">The stream doesn't contain a supported snapshot</exception>
+        public static int LoadSnapshot(Stream stream)
+        {
+            if (stream == null)
+                throw new ArgumentNullException(nameof(stream));
+
+            var loaded = new List<SnapshotEntry>();
+
+            using (var r = new BinaryReader(stream, Encoding.UTF8, true))
+            {
+                if (r.ReadInt32() != SnapshotMagic || r.ReadInt32() != SnapshotVersion)
+                    throw new InvalidDataException("Not a supported SRID register snapshot");
+
+                bool sameProj = (r.ReadString() == ProjContext.ProjVersion.ToString());
+
+                int count = r.ReadInt32();
+                for (int i = 0; i < count; i++)
+                {
+                    int srid = r.ReadInt32();
+                    var si = new SridSnapshotItem
+                    {
+                        ProjJson = r.ReadString(),
+                        Name = ReadNullable(r)
+                    };
+
+                    si.Identifiers = new Identifier[r.ReadInt32()];
+                    for (int j = 0; j < si.Identifiers.Length; j++)
+                        si.Identifiers[j] = new Identifier(r.ReadString(), r.ReadString());
+
+                    if (r.ReadBoolean())
+                    {
+                        si.UsageArea = new[] { r.ReadDouble(), r.ReadDouble(), r.ReadDouble(), r.ReadDouble() };
+                        si.UsageAreaName = ReadNullable(r);
+                    }
+
+                    var fp = new ProjFingerprint(r.ReadUInt64(), r.ReadUInt64());
+                    if (sameProj)
+                        si.Fingerprint = fp;
+
+                    PrecisionModel pm = null;
+                    if (r.ReadBoolean())
+                    {
+                        var type = (PrecisionModels)r.ReadInt32();
+                        double scale = r.ReadDouble();
+
+                        pm = (type == PrecisionModels.Fixed) ? new PrecisionModel(scale) : new PrecisionModel(type);
+                    }
+
+                    int nIds = r.ReadInt32();
+                    var ids = new List<object>(nIds);
+                    for (int j = 0; j < nIds; j++)
+                    {
+                        Type t = Type.GetType(r.ReadString(), false);
+                        long v = r.ReadInt64();
+
+                        // Enums that no longer exist are ignored
+                        if (t != null && t.IsEnum)
+                            ids.Add(Enum.ToObject(t, v));
+                    }
+
+                    loaded.Add(new SnapshotEntry { Srid = srid, Item = si, Fingerprint = si.Fingerprint, PrecisionModel = pm, Ids = ids });
+                }
+            }
+
+            int added = 0;
+            using (_rwl.WithWriteLock())
+            {
+                foreach (var l in loaded)
+                {
+                    if (_catalog.ContainsKey(l.Srid) || l.Ids.Any(WithinWriteLock_IsIdRegistered))
+                        continue;
+
+                    var item = new SridItem(l.Item, l.Srid, l.PrecisionModel);
+                    _catalog.Add(l.Srid, item);
+                    _snapshotItems.Add(item);
+                    added++;
+
+                    if (!l.Fingerprint.IsEmpty)
+                        WithinWriteLock_AddFingerprint(l.Fingerprint, item);
+
+                    foreach (object id in l.Ids)
+                    {
+                        _withinWriteLock_TryRegisterId.MakeGenericMethod(id.GetType()).Invoke(null, new[] { item, id });
+                    }
+                }
+            }
+            return added;
+        }
+
+        static bool WithinWriteLock_IsIdRegistered(object id)
+        {
+            return (bool)_withinWriteLock_HasId.MakeGenericMethod(id.GetType()).Invoke(null, new[] { id });
+        }
+
+        static bool WithinWriteLock_HasId<T>(T value) where T : Enum
+        {
+            int n = GetIdType<T>();
+
+            return n < _dicts.Count && _dicts[n] != null && _dicts[n].Contains(value);
+        }
+
+        static readonly MethodInfo _withinWriteLock_HasId = typeof(SridRegister).GetMethod(nameof(WithinWriteLock_HasId), BindingFlags.NonPublic | BindingFlags.Static);
+        static readonly MethodInfo _withinWriteLock_TryRegisterId = typeof(SridRegister).GetMethod(nameof(WithingWriteLock_TryRegisterId), BindingFlags.NonPublic | BindingFlags.Static);
+
+        internal static CoordinateReferenceSystem CreateFromSnapshot(SridItem item)
+        {
+            var crs = CoordinateReferenceSystem.Create(item.Snapshot.ProjJson);
+
+            _created.TryAdd(crs, item);
+            return crs;
+        }
+
+        sealed class SnapshotEntry
+        {
+            public int Srid;
+            public SridSnapshotItem Item;
+            public ProjFingerprint Fingerprint;
+            public PrecisionModel PrecisionModel;
+            public List<object> Ids;
+        }
+
+        static void WriteNullable(BinaryWriter w, string value)
+        {
+            w.Write(value != null);
+            if (value != null)
+                w.Write(value);
+        }
+
+        static string ReadNullable(BinaryReader r)
+        {
+            return r.ReadBoolean() ? r.ReadString() : null;
+        }
+    }
+}
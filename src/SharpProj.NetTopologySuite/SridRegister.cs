@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.Threading;
 using SharpProj.Implementation;
+using SharpProj.Proj;
 
 namespace SharpProj.NTS
 {
@@ -12,6 +13,7 @@ namespace SharpProj.NTS
     {
         static readonly Dictionary<int, SridItem> _catalog = new Dictionary<int, SridItem>();
         static readonly Dictionary<CoordinateReferenceSystem, SridItem> _registered = new Dictionary<CoordinateReferenceSystem, SridItem>();
+        static readonly Dictionary<ProjFingerprint, SridItem> _byFingerprint = new Dictionary<ProjFingerprint, SridItem>();
 
         static ReaderWriterLockSlim _rwl = new ReaderWriterLockSlim();
         static List<System.Collections.IDictionary> _dicts = new List<System.Collections.IDictionary>();
@@ -101,7 +103,11 @@ namespace SharpProj.NTS
         {
             using (_rwl.WithReadLock())
             {
-                if (_registered.TryGetValue(crs, out var item))
+                if (_registered.TryGetValue(crs, out var item) || _created.TryGetValue(crs, out item))
+                    return item;
+
+                // Same definition as a registered CRS, without pairwise comparisons
+                if (_byFingerprint.TryGetValue(crs.Fingerprint, out item))
                     return item;
 
                 foreach (SridItem it in _registered.Values)
@@ -109,6 +115,13 @@ namespace SharpProj.NTS
                     if (it.CRS.IsEquivalentTo(crs))
                         return it;
                 }
+
+                // Items loaded from a snapshot. Only check the created CRSs and the likely candidates, to keep the others lazy
+                foreach (SridItem it in _snapshotItems)
+                {
+                    if ((it.IsCRSCreated || it.Snapshot.MightMatch(crs)) && it.CRS.IsEquivalentTo(crs))
+                        return it;
+                }
             }
             return Register(crs.Clone());
         }
@@ -163,6 +176,7 @@ namespace SharpProj.NTS
 
             _registered.Add(crs, added);
             _catalog.Add(withSrid, added);
+            WithinWriteLock_AddFingerprint(crs, added);
 
             return added;
         }
@@ -182,7 +196,7 @@ namespace SharpProj.NTS
 
             using (_rwl.WithWriteLock())
             {
-                if (_registered.ContainsKey(crs))
+                if (_registered.ContainsKey(crs) || _created.ContainsKey(crs))
                     throw new ArgumentException("CRS instance already registered", nameof(crs));
 
                 return WithinWriteLock_Register(crs, args);
@@ -208,10 +222,23 @@ namespace SharpProj.NTS
 
             _registered.Add(crs, added);
             _catalog.Add(_nextId, added);
+            WithinWriteLock_AddFingerprint(crs, added);
 
             return added;
         }
 
+        static void WithinWriteLock_AddFingerprint(CoordinateReferenceSystem crs, SridItem item)
+        {
+            WithinWriteLock_AddFingerprint(crs.Fingerprint, item);
+        }
+
+        static void WithinWriteLock_AddFingerprint(ProjFingerprint fp, SridItem item)
+        {
+            // First registration wins, like the linear lookup in FindEnsured
+            if (!_byFingerprint.ContainsKey(fp))
+                _byFingerprint.Add(fp, item);
+        }
+
         /// <summary>
         /// 
         /// </summary>
@@ -330,7 +357,7 @@ namespace SharpProj.NTS
 
             using (_rwl.WithWriteLock())
             {
-                if (_registered.ContainsKey(crs))
+                if (_registered.ContainsKey(crs) || _created.ContainsKey(crs))
                     throw new ArgumentException("CRS instance already registered", nameof(crs));
 
                 try
@@ -338,7 +365,7 @@ namespace SharpProj.NTS
                     item = null;
                     if (preferredSrid.HasValue && _catalog.TryGetValue(preferredSrid.Value, out item))
                     {
-                        if (item.CRS.IsEquivalentTo(crs))
+                        if (item.CRS.Fingerprint == crs.Fingerprint || item.CRS.IsEquivalentTo(crs))
                             return item;
                         preferredSrid = null;
                     }
@@ -640,6 +640,114 @@ namespace SharpProj.Tests
             }
         }
 
+        [TestMethod]
+        public void FilterReferenceSystems()
+        {
+            using (ProjContext pc = new ProjContext() { EnableNetworkConnections = false })
+            {
+                var all = pc.GetCoordinateReferenceSystems();
+                Assert.IsTrue(all.Count > 5000);
+                Assert.IsFalse(all.Any(x => x.IsDeprecated));
+
+                var rd = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter
+                {
+                    Authority = "EPSG",
+                    Types = { ProjType.ProjectedCrs },
+                    CoordinateArea = new CoordinateArea(5.0, 52.0, 5.1, 52.1),
+                    CompletelyContainsArea = true
+                });
+
+                Assert.IsTrue(rd.Any(x => x.Code == "28992"));
+                Assert.IsTrue(rd.All(x => x.Authority == "EPSG" && x.Type == ProjType.ProjectedCrs));
+                Assert.IsFalse(rd.Any(x => x.Code == "2193")); // NZGD2000 / New Zealand Transverse Mercator 2000
+
+                var amersfoort = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter { NamePrefix = "amersfoort / rd" });
+                Assert.IsTrue(amersfoort.Any(x => x.Name == "Amersfoort / RD New"));
+                Assert.IsTrue(amersfoort.All(x => x.Name.StartsWith("Amersfoort / RD", StringComparison.OrdinalIgnoreCase)));
+
+                // Geographic includes the 2D and 3D variants
+                var geographic = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter { Types = { ProjType.GeographicCrs } });
+                Assert.IsTrue(geographic.Any(x => x.Type == ProjType.Geographic2DCrs));
+                Assert.IsTrue(geographic.Any(x => x.Type == ProjType.Geographic3DCrs));
+
+                // Areas crossing the antimeridian
+                var fiji = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter { Authority = "EPSG", CoordinateArea = new CoordinateArea(179.5, -17.0, -179.5, -16.5) });
+                Assert.IsTrue(fiji.Any(x => x.Code == "3460")); // Fiji 1986 / Fiji Map Grid
+
+                // Same order as before, and answered from the same catalog
+                var again = pc.GetCoordinateReferenceSystems();
+                Assert.AreSame(all[0], again[0]);
+
+                using (var crs = rd.First(x => x.Code == "28992").Create())
+                    Assert.AreSame(pc, crs.Context);
+            }
+        }
+
+        [TestMethod]
+        public void FindReferenceSystemsByLocation()
+        {
+            using (ProjContext pc = new ProjContext() { EnableNetworkConnections = false })
+            {
+                var filter = new CoordinateReferenceSystemFilter { Types = { ProjType.ProjectedCrs } };
+                var amsterdam = pc.FindCoordinateReferenceSystems(4.9, 52.37, filter);
+
+                Assert.IsTrue(amsterdam.Any(x => x.Identifier.ToString() == "EPSG:28992"));
+                Assert.IsTrue(amsterdam.All(x => x.Type == ProjType.ProjectedCrs));
+                Assert.IsTrue(amsterdam.All(x => x.BoundingBox.WestLongitude <= 4.9 && x.BoundingBox.EastLongitude >= 4.9
+                                              && x.BoundingBox.SouthLatitude <= 52.37 && x.BoundingBox.NorthLatitude >= 52.37));
+
+                // Most specific first
+                var first = amsterdam.First().BoundingBox;
+                var last = amsterdam.Last().BoundingBox;
+                Assert.IsTrue((first.EastLongitude - first.WestLongitude) * (first.NorthLatitude - first.SouthLatitude)
+                              <= (last.EastLongitude - last.WestLongitude) * (last.NorthLatitude - last.SouthLatitude));
+
+                // Area crossing the antimeridian
+                var fiji = pc.FindCoordinateReferenceSystems(new CoordinateArea(179.9, -17.0, -179.9, -16.9));
+                Assert.IsTrue(fiji.Any(x => x.Identifier.ToString() == "EPSG:3460"));
+                Assert.IsFalse(fiji.Any(x => x.Identifier.ToString() == "EPSG:28992"));
+
+                // Same results as the filter based query, apart from the order
+                var viaFilter = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter
+                {
+                    Types = { ProjType.ProjectedCrs },
+                    CoordinateArea = new CoordinateArea(4.9, 52.37, 4.9, 52.37),
+                    CompletelyContainsArea = true
+                });
+                CollectionAssert.AreEquivalent(viaFilter.ToList(), amsterdam.ToList());
+            }
+        }
+
+        [TestMethod]
+        public void SearchReferenceSystems()
+        {
+            using (ProjContext pc = new ProjContext() { EnableNetworkConnections = false })
+            {
+                var rd = pc.SearchCoordinateReferenceSystems("amersfoort rd new");
+                Assert.AreEqual("EPSG:28992", rd.First().Identifier.ToString());
+
+                // Substrings, case and diacritics insensitive
+                Assert.IsTrue(pc.SearchCoordinateReferenceSystems("MERSFOOR").Any(x => x.Identifier.ToString() == "EPSG:28992"));
+                Assert.IsTrue(pc.SearchCoordinateReferenceSystems("Amérsfoort RD").Any(x => x.Identifier.ToString() == "EPSG:28992"));
+
+                // Area names and projection names
+                Assert.IsTrue(pc.SearchCoordinateReferenceSystems("netherlands oblique stereographic").Any(x => x.Identifier.ToString() == "EPSG:28992"));
+
+                Assert.AreEqual(0, pc.SearchCoordinateReferenceSystems("qqqqxxxx").Count);
+
+                var limited = pc.SearchCoordinateReferenceSystems("utm", 5, new CoordinateReferenceSystemFilter { Authority = "EPSG" });
+                Assert.AreEqual(5, limited.Count);
+                Assert.IsTrue(limited.All(x => x.Authority == "EPSG" && !x.IsDeprecated));
+
+                var sw = System.Diagnostics.Stopwatch.StartNew();
+                const int n = 100;
+                for (int i = 0; i < n; i++)
+                    pc.SearchCoordinateReferenceSystems("amersfoort / rd", 20, null);
+                sw.Stop();
+                TestContext.WriteLine($"Search: {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F1} us");
+            }
+        }
+
         [TestMethod]
         public void WalkBodies()
         {
@@ -1050,5 +1158,553 @@ namespace SharpProj.Tests
             else
                 Assert.Fail("Expected choose transform");
         }
+
+        [TestMethod]
+        public void Fingerprint()
+        {
+            using (var pc = new ProjContext())
+            using (var rd1 = CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+            using (var rd2 = CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+            {
+                Assert.AreNotSame(rd1, rd2);
+                Assert.IsFalse(rd1.Fingerprint.IsEmpty);
+                Assert.AreEqual(rd1.Fingerprint, rd2.Fingerprint);
+                Assert.AreNotEqual(rd1.Fingerprint, wgs84.Fingerprint);
+                Assert.AreNotEqual(wgs84.Fingerprint, wgs84.WithNormalizedAxis().Fingerprint);
+
+                // Identifiers and usages don't change the fingerprint
+                string wkt = System.Text.RegularExpressions.Regex.Replace(rd1.AsWellKnownText(), @",\s*ID\[""EPSG"",28992\]\s*\]\s*$", "]");
+                using (var noId = CoordinateReferenceSystem.CreateFromWellKnownText(wkt, pc))
+                {
+                    Assert.IsNull(noId.Identifiers);
+                    Assert.AreEqual(rd1.Fingerprint, noId.Fingerprint);
+                }
+
+                var d = new Dictionary<ProjFingerprint, CoordinateReferenceSystem> { [rd1.Fingerprint] = rd1, [wgs84.Fingerprint] = wgs84 };
+                Assert.AreSame(rd1, d[rd2.Fingerprint]);
+
+                using (var t1 = CoordinateTransform.Create(rd1, wgs84, pc))
+                using (var t2 = CoordinateTransform.Create(rd2, wgs84, pc))
+                {
+                    Assert.AreEqual(t1.Fingerprint, t2.Fingerprint);
+                    Assert.AreNotEqual(rd1.Fingerprint, t1.Fingerprint);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void ParseDefinitions()
+        {
+            Assert.AreEqual("GEOGCS[\"WGS  84\",DATUM[\"x\"]]", CoordinateReferenceSystemParser.Normalize("\uFEFF GEOGCS[ \"WGS  84\" ,\r\n  DATUM[\"x\"] ]\n"));
+            Assert.AreEqual("+proj=longlat +datum=WGS84", CoordinateReferenceSystemParser.Normalize("  +proj=longlat \t +datum=WGS84 "));
+
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+            using (var rd = CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+            using (var parser = new CoordinateReferenceSystemParser(pc))
+            {
+                string wkt1 = wgs84.AsWellKnownText(new WktOptions { WktType = WktType.WKT1_GDAL });
+                string wkt2 = rd.AsWellKnownText();
+
+                var crs = parser.Parse(wkt1);
+                Assert.AreSame(crs, parser.Parse(wkt1.Replace(",", ",\n    ")));
+                Assert.AreEqual(1, parser.Misses);
+                Assert.AreEqual(1, parser.Hits);
+                Assert.IsTrue(crs.IsEquivalentToRelaxed(wgs84));
+
+                Assert.IsFalse(parser.TryParse("+proj=nonexisting", out var none));
+                Assert.IsNull(none);
+                Assert.IsFalse(parser.TryParse("  ", out none));
+                Assert.IsNull(none);
+
+                // Every caller gets its own exception
+                var failures = new List<ProjException>();
+                for (int i = 0; i < 2; i++)
+                {
+                    try
+                    {
+                        parser.Parse("+proj=nonexisting");
+                    }
+                    catch (ProjException pe)
+                    {
+                        failures.Add(pe);
+                    }
+                }
+                Assert.AreEqual(2, failures.Count);
+                Assert.AreNotSame(failures[0], failures[1]);
+                Assert.AreEqual(failures[0].Message, failures[1].Message);
+
+                using (var pc2 = new ProjContext())
+                using (var own = parser.Parse(wkt1, pc2))
+                {
+                    Assert.AreSame(pc2, own.Context);
+                    Assert.AreNotSame(crs, own);
+                    Assert.IsTrue(own.IsEquivalentTo(crs));
+                }
+
+                var input = new List<string>();
+                for (int i = 0; i < 100; i++)
+                {
+                    input.Add(i % 2 == 0 ? wkt2 : "  " + wkt2 + "\r\n");
+                    input.Add(wkt1);
+                    input.Add("+proj=utm +zone=" + (i % 60 + 1) + " +datum=WGS84");
+                    input.Add("GEOGCS[\"broken\"");
+                }
+
+                var crss = parser.Parse(input, out var errors);
+                Assert.AreEqual(input.Count, crss.Length);
+
+                for (int i = 0; i < input.Count; i++)
+                {
+                    if (i % 4 == 3)
+                    {
+                        Assert.IsNull(crss[i]);
+                        Assert.IsNotNull(errors[i]);
+                    }
+                    else
+                    {
+                        Assert.IsNull(errors[i], $"Error parsing {input[i]}");
+                        Assert.AreSame(pc, crss[i].Context);
+                    }
+                }
+
+                Assert.AreSame(crss[0], crss[4]);
+                Assert.AreSame(crs, crss[1]);
+                Assert.IsTrue(crss[0].IsEquivalentTo(rd));
+                Assert.AreEqual(64, parser.Count); // 2 WKTs, 60 UTM zones and 2 failures
+            }
+        }
+
+        [TestMethod]
+        public void TransformBounds()
+        {
+            using (var pc = new ProjContext())
+            using (var rd = CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var t = CoordinateTransform.Create(rd, wgs84, pc))
+            {
+                var b = t.TransformBounds(0, 300000, 280000, 625000);
+                Assert.AreEqual(3.3, b[0], 0.1);
+                Assert.AreEqual(50.6, b[1], 0.1);
+                Assert.AreEqual(7.4, b[2], 0.1);
+                Assert.AreEqual(53.6, b[3], 0.1);
+
+                var back = t.TransformBoundsReversed(b[0], b[1], b[2], b[3]);
+                Assert.IsTrue(back[0] <= 0 && back[1] <= 300000 && back[2] >= 280000 && back[3] >= 625000);
+
+                // Batch of tiles must match the individual results
+                var boxes = new List<double>();
+                for (int x = 0; x < 280000; x += 20000)
+                    for (int y = 300000; y < 625000; y += 25000)
+                        boxes.AddRange(new double[] { x, y, x + 20000, y + 25000 });
+
+                var all = boxes.ToArray();
+                t.TransformBounds(all);
+
+                for (int i = 0; i < all.Length; i += 4)
+                {
+                    var one = t.TransformBounds(boxes[i], boxes[i + 1], boxes[i + 2], boxes[i + 3]);
+                    for (int j = 0; j < 4; j++)
+                        Assert.AreEqual(one[j], all[i + j], 1e-12);
+                }
+
+                // Crossing the antimeridian in a geographic CRS
+                using (var wgs84D = CoordinateTransform.Create(wgs84, wgs84, pc))
+                {
+                    var am = wgs84D.TransformBounds(170, -10, -170, 10);
+                    Assert.AreEqual(170, am[0], 1e-9);
+                    Assert.AreEqual(-170, am[2], 1e-9);
+                }
+
+                // Around the pole
+                using (var polar = CoordinateReferenceSystem.CreateFromEpsg(3413, pc)) // NSIDC Sea Ice Polar Stereographic North
+                using (var tp = CoordinateTransform.Create(polar, wgs84, pc))
+                {
+                    var pb = tp.TransformBounds(-1000000, -1000000, 1000000, 1000000);
+                    Assert.AreEqual(-180, pb[0]);
+                    Assert.AreEqual(180, pb[2]);
+                    Assert.AreEqual(90, pb[3]);
+                }
+
+                // Around the pole, with a geographic source box that crosses the antimeridian
+                using (var rotated = CoordinateReferenceSystem.Create("+proj=ob_tran +o_proj=longlat +o_lon_p=0 +o_lat_p=30 +lon_0=0 +datum=WGS84 +no_defs +type=crs", pc))
+                using (var tr = CoordinateTransform.Create(rotated, wgs84, pc))
+                {
+                    var pole = tr.ApplyReversed(new PPoint(0, 90));
+                    double west = pole.X - 10;
+                    double east = pole.X - 20; // All longitudes but a 10 degree gap west of the pole
+                    if (west < -180)
+                        west += 360;
+                    if (east < -180)
+                        east += 360;
+                    Assert.IsTrue(west > east);
+
+                    var rb = tr.TransformBounds(west, pole.Y - 10, east, pole.Y + 10);
+                    Assert.AreEqual(-180, rb[0]);
+                    Assert.AreEqual(180, rb[2]);
+                    Assert.AreEqual(90, rb[3]);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void TransformBoundsAdaptive()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var polar = CoordinateReferenceSystem.CreateFromEpsg(3413, pc)) // NSIDC Sea Ice Polar Stereographic North
+            using (var utm = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            {
+                foreach (var crs in new[] { polar, utm })
+                {
+                    using (var t = CoordinateTransform.Create(crs, wgs84, pc))
+                    {
+                        var ua = crs.UsageArea;
+                        var dense = t.TransformBoundsReversed(ua.WestLongitude, ua.SouthLatitude, ua.EastLongitude, ua.NorthLatitude, 2000);
+                        var adaptive = t.TransformBoundsReversed(ua.WestLongitude, ua.SouthLatitude, ua.EastLongitude, ua.NorthLatitude, 0.01, out var err);
+
+                        TestContext.WriteLine($"{crs.Name}: achieved error {err}");
+                        Assert.IsTrue(err <= 0.01, "Error within tolerance");
+
+                        for (int i = 0; i < 4; i++)
+                            Assert.AreEqual(dense[i], adaptive[i], 1.0, $"Bound {i} of {crs.Name}");
+                    }
+                }
+
+                // The pole is outside the domain of Mercator, so the top edge can't be resolved
+                using (var google = CoordinateReferenceSystem.CreateFromEpsg(3857, pc))
+                using (var t = CoordinateTransform.Create(wgs84, google, pc))
+                {
+                    var b = t.TransformBounds(0, 80, 10, 90, 0.01, out var err);
+
+                    Assert.IsTrue(double.IsPositiveInfinity(err));
+                    Assert.IsTrue(b[3] > 15000000);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void UsageAreaCorners()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var utm = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var t = CoordinateTransform.Create(utm, wgs84, pc))
+            {
+                var ua = utm.UsageArea;
+
+                // All corners are calculated together on first use; they should match a separate conversion
+                var corners = new[] { ua.NorthWestCorner, ua.NorthEastCorner, ua.SouthWestCorner, ua.SouthEastCorner };
+                var expected = new[]
+                {
+                    t.ApplyReversed(new PPoint(ua.WestLongitude, ua.NorthLatitude)),
+                    t.ApplyReversed(new PPoint(ua.EastLongitude, ua.NorthLatitude)),
+                    t.ApplyReversed(new PPoint(ua.WestLongitude, ua.SouthLatitude)),
+                    t.ApplyReversed(new PPoint(ua.EastLongitude, ua.SouthLatitude)),
+                };
+
+                for (int i = 0; i < 4; i++)
+                {
+                    Assert.AreEqual(expected[i].X, corners[i].X, 0.01, $"X of corner {i}");
+                    Assert.AreEqual(expected[i].Y, corners[i].Y, 0.01, $"Y of corner {i}");
+                }
+
+                Assert.IsTrue(ua.MinX <= ua.SouthWestCorner.X);
+                Assert.IsTrue(ua.MaxY >= ua.NorthEastCorner.Y);
+            }
+        }
+
+        [TestMethod]
+        public void AreaContains()
+        {
+            var pacific = new ProjArea(170, -10, -170, 10);
+            var c = pacific.Contains(new double[] { 180, -175, 0, 530, double.NaN }, new double[] { 0, 0, 0, 0, 0 });
+
+            Assert.AreEqual(5, c.Length);
+            Assert.IsTrue(c[0] && c[1] && c[3]);
+            Assert.IsFalse(c[2] || c[4]);
+            Assert.IsFalse(pacific.Contains(175, 20));
+
+            using (var pc = new ProjContext())
+            using (var utm = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            {
+                var ua = utm.UsageArea;
+                int n = 100000;
+                var xs = new double[n];
+                var ys = new double[n];
+
+                for (int i = 0; i < n; i++)
+                {
+                    xs[i] = 500000;
+                    ys[i] = (i % 2 == 0) ? 5000000 : -5000000; // North of the equator is inside UTM 31N
+                }
+
+                var inside = ua.ContainsCoordinates(xs, ys);
+                Assert.AreEqual(n, inside.Length);
+
+                for (int i = 0; i < n; i++)
+                    Assert.AreEqual(i % 2 == 0, inside[i], $"Coordinate {i}");
+
+                Assert.IsTrue(ua.ContainsCoordinate(new PPoint(500000, 5000000)));
+                Assert.IsFalse(ua.ContainsCoordinate(new PPoint(double.NaN, double.NaN)));
+            }
+        }
+
+        [TestMethod]
+        public void FactorsBatch()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var utm = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var t = CoordinateTransform.Create(wgs84, utm, pc))
+            {
+                int columns = 100, rows = 120; // Large enough to be divided over threads
+                var result = new CoordinateTransformFactorArrays
+                {
+                    MeridionalScale = new double[columns * rows],
+                    AngularDistortion = new double[columns * rows],
+                    MeridianConvergence = new double[columns * rows],
+                };
+
+                t.Factors(0, 0, 0.06, 0.5, columns, rows, result);
+
+                foreach (int i in new[] { 0, 99, 5050, columns * rows - 1 })
+                {
+                    var f = t.Factors(new PPoint(0.06 * (i % columns), 0.5 * (i / columns)));
+
+                    Assert.AreEqual(f.MeridionalScale, result.MeridionalScale[i], 1e-12, $"Scale at {i}");
+                    Assert.AreEqual(f.AngularDistortion, result.AngularDistortion[i], 1e-12, $"Distortion at {i}");
+                    Assert.AreEqual(f.MeridianConvergence, result.MeridianConvergence[i], 1e-12, $"Convergence at {i}");
+                }
+
+                // Central meridian at the equator
+                var points = new CoordinateTransformFactorArrays { MeridionalScale = new double[1] };
+                t.Factors(new double[] { 3 }, new double[] { 0 }, points);
+                Assert.AreEqual(0.9996, points.MeridionalScale[0], 1e-9);
+            }
+        }
+
+        [TestMethod]
+        public void RoundTripBatch()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var utm = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var t = CoordinateTransform.Create(wgs84, utm, pc))
+            {
+                int n = 50000;
+                var lon = new double[n];
+                var lat = new double[n];
+                var rnd = new Random(42);
+
+                for (int i = 0; i < n; i++)
+                {
+                    lon[i] = rnd.NextDouble() * 6;
+                    lat[i] = rnd.NextDouble() * 80;
+                }
+                lat[n - 1] = double.NaN;
+
+                var stats = t.RoundTrip(true, 3, lon, lat);
+
+                Assert.AreEqual(n, stats.Errors.Length);
+                Assert.AreEqual(n - 1, stats.Count);
+                Assert.AreEqual(1, stats.FailedCount);
+                Assert.IsTrue(double.IsNaN(stats.Errors[n - 1]));
+
+                TestContext.WriteLine($"Max={stats.Maximum}, Mean={stats.Mean}, Median={stats.Median}, P99={stats.Percentile(99)}");
+                Assert.IsTrue(stats.Maximum < 1e-6, "Round trip within a micrometer");
+                Assert.IsTrue(stats.Median <= stats.Percentile(99) && stats.Percentile(99) <= stats.Maximum);
+                Assert.IsTrue(stats.Mean >= 0);
+
+                var reverse = t.RoundTrip(false, 1, new double[] { 500000 }, new double[] { 5000000 });
+                Assert.AreEqual(1, reverse.Count);
+                Assert.IsTrue(reverse.Maximum < 1e-6);
+            }
+        }
+
+        [TestMethod]
+        public void ApproximateTransform()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc).WithNormalizedAxis())
+            using (var polar = CoordinateReferenceSystem.CreateFromEpsg(3413, pc)) // NSIDC Sea Ice Polar Stereographic North
+            using (var t = CoordinateTransform.Create(wgs84, polar, pc))
+            using (var approx = t.CreateApproximation(-30, 40, 40, 85, 1.0))
+            {
+                Assert.IsTrue(approx.CellCount > 0);
+                Assert.AreEqual(1.0, approx.MaxError);
+
+                var rnd = new Random(12);
+                int n = 10000;
+                var xs = new double[n];
+                var ys = new double[n];
+
+                for (int i = 0; i < n; i++)
+                {
+                    xs[i] = -40 + rnd.NextDouble() * 90; // Partly outside the area
+                    ys[i] = 40 + rnd.NextDouble() * 45;
+                }
+
+                var ax = (double[])xs.Clone();
+                var ay = (double[])ys.Clone();
+                approx.Apply(ax, ay);
+                t.Apply(xs, ys);
+
+                for (int i = 0; i < n; i++)
+                {
+                    Assert.AreEqual(xs[i], ax[i], 1.0, $"X of {i}");
+                    Assert.AreEqual(ys[i], ay[i], 1.0, $"Y of {i}");
+                }
+
+                // Reverse transforms are exact
+                var p = t.Apply(new PPoint(5, 60));
+                var r = approx.ApplyReversed(p);
+                Assert.AreEqual(5, r.X, 1e-9);
+                Assert.AreEqual(60, r.Y, 1e-9);
+            }
+        }
+
+        [TestMethod]
+        public void FastPathTransform()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+            using (var wgs84n = wgs84.WithNormalizedAxis())
+            using (var utm31 = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var google = CoordinateReferenceSystem.CreateFromEpsg(3857, pc))
+            using (var tUtmAuto = CoordinateTransform.Create(wgs84, utm31, pc))
+            using (var tUtm = CoordinateTransform.Create("+proj=pipeline +step +proj=axisswap +order=2,1 +step +proj=unitconvert +xy_in=deg +xy_out=rad +step +proj=utm +zone=31 +ellps=WGS84 +algo=poder_engsager", pc))
+            using (var tGoogle = CoordinateTransform.Create(wgs84n, google, pc))
+            {
+                Assert.IsFalse(tUtmAuto.HasFastPath, "PROJ's default approximates near the central meridian");
+                Assert.IsTrue(tUtm.HasFastPath);
+                Assert.IsTrue(tGoogle.HasFastPath);
+
+                var rnd = new Random(48);
+                int n = 1000;
+                var lat = new double[n];
+                var lon = new double[n];
+
+                for (int i = 0; i < n; i++)
+                {
+                    lat[i] = -80 + rnd.NextDouble() * 164;
+                    lon[i] = -3 + rnd.NextDouble() * 12;
+                }
+                lat[0] = 89.9; // Outside the native domain, left to PROJ
+                lat[1] = 60;
+                lon[1] = 48;
+
+                // Axis order of EPSG:4326 is (lat, lon)
+                var xs = (double[])lat.Clone();
+                var ys = (double[])lon.Clone();
+                tUtm.Apply(xs, ys);
+
+                for (int i = 0; i < n; i++)
+                {
+                    PPoint p = tUtm.Apply(new PPoint(lat[i], lon[i]));
+                    Assert.AreEqual(p.X, xs[i], 1e-6, $"X of {i}");
+                    Assert.AreEqual(p.Y, ys[i], 1e-6, $"Y of {i}");
+                }
+
+                tUtm.ApplyReversed(xs, ys);
+                for (int i = 0; i < n; i++)
+                {
+                    Assert.AreEqual(lat[i], xs[i], 1e-9, $"Lat of {i}");
+                    Assert.AreEqual(lon[i], ys[i], 1e-9, $"Lon of {i}");
+                }
+
+                xs = (double[])lon.Clone();
+                ys = (double[])lat.Clone();
+                tGoogle.Apply(xs, ys);
+
+                for (int i = 0; i < n; i++)
+                {
+                    PPoint p = tGoogle.Apply(new PPoint(lon[i], lat[i]));
+                    Assert.AreEqual(p.X, xs[i], 1e-6, $"X of {i}");
+                    Assert.AreEqual(p.Y, ys[i], 1e-6, $"Y of {i}");
+                }
+            }
+        }
+
+        [TestMethod]
+        public void ProjOperationsParsed()
+        {
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+            using (var utm31 = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var t = CoordinateTransform.Create(wgs84, utm31, pc))
+            using (var inv = t.CreateInverse(pc))
+            {
+                var ops = t.ProjOperations();
+                Assert.AreSame(ops, t.ProjOperations(), "Cached");
+
+                Assert.AreEqual(3, ops.Count);
+                Assert.AreEqual("axisswap", ops[0].Name);
+                Assert.AreEqual("2,1", ops[0]["order"]);
+                Assert.AreEqual("unitconvert", ops[1].Name);
+                Assert.AreEqual("deg", ops[1]["xy_in"]);
+
+                var utm = ops[2];
+                Assert.AreEqual("utm", utm.Name);
+                Assert.AreEqual(ProjOperationType.Projection, utm.Type);
+                Assert.AreEqual("31", utm["zone"]);
+                Assert.AreEqual("WGS84", utm["ellps"]);
+                Assert.IsNull(utm["lat_0"]);
+                Assert.IsFalse(utm.IsInverse);
+                Assert.AreEqual("proj=utm zone=31 ellps=WGS84", utm.ToString());
+
+                var invUtm = inv.ProjOperations().First();
+                Assert.AreEqual("utm", invUtm.Name);
+                Assert.IsTrue(invUtm.IsInverse);
+                Assert.IsFalse(invUtm.IsInverseOnly);
+                Assert.IsFalse(invUtm.IsForwardOnly);
+            }
+        }
+
+        [TestMethod]
+        public void ProjOperationsWithoutProjString()
+        {
+            const string geog = "GEOGCRS[\"WGS 84\",DATUM[\"World Geodetic System 1984\",ELLIPSOID[\"WGS 84\",6378137,298.257223563]],CS[ellipsoidal,2],AXIS[\"latitude\",north,ANGLEUNIT[\"degree\",0.0174532925199433]],AXIS[\"longitude\",east,ANGLEUNIT[\"degree\",0.0174532925199433]]]";
+            // A method PROJ can't express as PROJ string
+            string wkt = $"COORDINATEOPERATION[\"Test\",SOURCECRS[{geog}],TARGETCRS[{geog}],METHOD[\"SharpProj test method\"],PARAMETER[\"Scale\",1,SCALEUNIT[\"unity\",1]]]";
+
+            using (var pc = new ProjContext())
+            using (var t = CoordinateTransform.Create(wkt, pc))
+            {
+                var ops = t.ProjOperations();
+
+                Assert.AreEqual(0, ops.Count);
+                Assert.IsFalse(ops.Any());
+            }
+        }
+
+        [TestMethod]
+        public void FindFileCachesUntilCleared()
+        {
+            var findFile = typeof(ProjContext).GetMethod("FindFile", System.Reflection.BindingFlags.NonPublic | System.Reflection.BindingFlags.Instance);
+            string name = $"sharpproj-test-{Guid.NewGuid():N}.txt";
+            string path = Path.Combine(Path.GetDirectoryName(typeof(ProjContext).Assembly.Location), name);
+
+            using (var pc = new ProjContext())
+            {
+                File.WriteAllText(path, "test");
+                try
+                {
+                    Assert.AreEqual(path, (string)findFile.Invoke(pc, new object[] { name }));
+                    Assert.AreEqual(path, (string)findFile.Invoke(pc, new object[] { name }));
+                }
+                finally
+                {
+                    File.Delete(path);
+                }
+
+                // Hits are not checked against the file system
+                Assert.AreEqual(path, (string)findFile.Invoke(pc, new object[] { name }));
+
+                ProjContext.ClearFileCache();
+                Assert.IsNull((string)findFile.Invoke(pc, new object[] { name }));
+            }
+        }
     }
 }
@@ -0,0 +1,380 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Tasks;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SharpProj.Proj;
+
+namespace SharpProj.Tests
+{
+    [TestClass]
+    public class PerformanceTests
+    {
+        public TestContext TestContext { get; set; }
+
+        [TestMethod]
+        public void ContextCreation()
+        {
+            const int n = 1000;
+
+            // Warm up: resolves search paths and configures the template for new contexts
+            using (new ProjContext())
+            { }
+
+            var sw = Stopwatch.StartNew();
+            for (int i = 0; i < n; i++)
+            {
+                using (new ProjContext())
+                { }
+            }
+            sw.Stop();
+            TestContext.WriteLine($"new ProjContext(): {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F1} us");
+
+            using (var pc = new ProjContext())
+            {
+                sw.Restart();
+                for (int i = 0; i < n; i++)
+                {
+                    using (pc.Clone())
+                    { }
+                }
+                sw.Stop();
+                TestContext.WriteLine($"ProjContext.Clone(): {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F1} us");
+
+                using (var clone = pc.Clone())
+                using (var crs = CoordinateReferenceSystem.CreateFromEpsg(25832, clone))
+                {
+                    Assert.AreEqual(ProjLogLevel.Error, clone.LogLevel);
+                    Assert.AreEqual(pc.EnableNetworkConnections, clone.EnableNetworkConnections);
+                    Assert.AreEqual("ETRS89 / UTM zone 32N", crs.Name);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void Utf8Conversion()
+        {
+            const int n = 1000;
+            // Non ASCII characters, including a surrogate pair
+            string name = "Réseau géodésique \u00FC\u20AC \U0001F30D";
+            string wkt = $"GEOGCRS[\"{name}\",DATUM[\"World Geodetic System 1984\",ELLIPSOID[\"WGS 84\",6378137,298.257223563]],CS[ellipsoidal,2],AXIS[\"latitude\",north,ANGLEUNIT[\"degree\",0.0174532925199433]],AXIS[\"longitude\",east,ANGLEUNIT[\"degree\",0.0174532925199433]]]";
+
+            using (var pc = new ProjContext())
+            {
+                using (var crs = CoordinateReferenceSystem.CreateFromWellKnownText(wkt, pc))
+                    Assert.AreEqual(name, crs.Name);
+
+                long arenaBefore = ProjContext.StringArenaAllocations;
+                var sw = Stopwatch.StartNew();
+                for (int i = 0; i < n; i++)
+                {
+                    using (CoordinateReferenceSystem.CreateFromWellKnownText(wkt, pc))
+                    { }
+                    using (CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+                    { }
+                }
+                sw.Stop();
+
+                TestContext.WriteLine($"Create from WKT and EPSG: {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F1} us");
+                TestContext.WriteLine($"String arena blocks allocated: {ProjContext.StringArenaAllocations - arenaBefore}");
+            }
+        }
+
+        [TestMethod]
+        public void InternedCrsCreation()
+        {
+            const int n = 1000;
+
+            using (var pc = new ProjContext())
+            {
+                using (CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+                { }
+
+                long hits = CoordinateReferenceSystemCache.Hits;
+                var sw = Stopwatch.StartNew();
+                for (int i = 0; i < n; i++)
+                {
+                    using (var crs = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+                    { }
+                }
+                sw.Stop();
+                TestContext.WriteLine($"CreateFromEpsg(4326): {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F1} us");
+
+                Assert.IsTrue(CoordinateReferenceSystemCache.Hits >= hits + n);
+            }
+
+            // Handles in other contexts are independent
+            using (var pc2 = new ProjContext())
+            using (var crs = CoordinateReferenceSystem.CreateFromEpsg(4326, pc2))
+            {
+                Assert.AreEqual("WGS 84", crs.Name);
+                Assert.AreEqual("EPSG", crs.Identifiers[0].Authority);
+                Assert.AreEqual("4326", crs.Identifiers[0].Code);
+                Assert.AreSame(pc2, crs.Context);
+            }
+        }
+
+        [TestMethod]
+        public void BatchCrsCreation()
+        {
+            using (var pc = new ProjContext())
+            {
+                var ids = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter { Authority = "EPSG" })
+                            .Take(2000).Select(x => x.Identifier).ToList();
+                ids.Add(new Proj.Identifier("EPSG", "-1"));
+
+                CoordinateReferenceSystemCache.Clear();
+                var sw = Stopwatch.StartNew();
+                var crss = CoordinateReferenceSystem.CreateFromDatabase(ids, out var errors, pc);
+                sw.Stop();
+                TestContext.WriteLine($"Batch: {ids.Count} CRSs in {sw.Elapsed.TotalMilliseconds:F0} ms");
+
+                try
+                {
+                    Assert.AreEqual(ids.Count, crss.Length);
+                    Assert.IsNull(crss[ids.Count - 1]);
+                    Assert.IsNotNull(errors[ids.Count - 1]);
+
+                    for (int i = 0; i < ids.Count - 1; i++)
+                    {
+                        Assert.IsNull(errors[i], $"Error creating {ids[i]}");
+                        Assert.AreSame(pc, crss[i].Context);
+                        Assert.AreEqual(ids[i], crss[i].Identifier);
+                    }
+                }
+                finally
+                {
+                    foreach (var c in crss)
+                        c?.Dispose();
+                }
+
+                CoordinateReferenceSystemCache.Clear();
+                sw.Restart();
+                foreach (var id in ids.Take(ids.Count - 1))
+                {
+                    using (CoordinateReferenceSystem.CreateFromDatabase(id, pc))
+                    { }
+                }
+                sw.Stop();
+                TestContext.WriteLine($"Sequential: {ids.Count - 1} CRSs in {sw.Elapsed.TotalMilliseconds:F0} ms");
+
+                // The most recently used definitions are now cached, and found with a single lookup
+                long hits = CoordinateReferenceSystemCache.Hits;
+                sw.Restart();
+                crss = CoordinateReferenceSystem.CreateFromDatabase(ids, out errors, pc);
+                sw.Stop();
+                TestContext.WriteLine($"Batch after sequential: {ids.Count} CRSs in {sw.Elapsed.TotalMilliseconds:F0} ms");
+
+                try
+                {
+                    Assert.IsTrue(CoordinateReferenceSystemCache.Hits >= hits + Math.Min(ids.Count - 1, CoordinateReferenceSystemCache.Capacity));
+
+                    for (int i = 0; i < ids.Count - 1; i++)
+                        Assert.AreEqual(ids[i], crss[i].Identifier);
+                }
+                finally
+                {
+                    foreach (var c in crss)
+                        c?.Dispose();
+                }
+            }
+        }
+
+        [TestMethod]
+        public void DescribeCrs()
+        {
+            using (var pc = new ProjContext())
+            {
+                var ids = pc.GetCoordinateReferenceSystems(new CoordinateReferenceSystemFilter { Authority = "EPSG" })
+                            .Take(500).Select(x => x.Identifier).ToList();
+
+                var a = CoordinateReferenceSystem.CreateFromDatabase(ids, out _, pc);
+                var b = CoordinateReferenceSystem.CreateFromDatabase(ids, out _, pc);
+                try
+                {
+                    var sw = Stopwatch.StartNew();
+                    foreach (var crs in a)
+                    {
+                        GC.KeepAlive(crs.GeodeticCRS?.Name);
+                        GC.KeepAlive(crs.Datum?.Name);
+                        GC.KeepAlive(crs.Ellipsoid?.SemiMajorMetre);
+                        GC.KeepAlive(crs.PrimeMeridian?.Longitude);
+                        GC.KeepAlive(crs.CoordinateSystem?.CoordinateSystemType);
+                        if (crs.Axis != null)
+                            foreach (var ax in crs.Axis)
+                                GC.KeepAlive(ax.Name);
+                        GC.KeepAlive(crs.UsageArea?.Name);
+                    }
+                    sw.Stop();
+                    TestContext.WriteLine($"Properties: {ids.Count} CRSs in {sw.Elapsed.TotalMilliseconds:F0} ms");
+
+                    sw.Restart();
+                    foreach (var crs in b)
+                        GC.KeepAlive(crs.Describe());
+                    sw.Stop();
+                    TestContext.WriteLine($"Describe(): {ids.Count} CRSs in {sw.Elapsed.TotalMilliseconds:F0} ms");
+
+                    for (int i = 0; i < a.Length; i++)
+                    {
+                        var crs = a[i];
+                        var d = b[i].Describe();
+
+                        Assert.AreSame(d, b[i].Describe());
+                        Assert.AreEqual(crs.Name, d.Name);
+                        Assert.AreEqual(crs.Type, d.Type);
+                        Assert.AreEqual(crs.Identifier, d.Identifier);
+                        Assert.AreEqual(crs.GeodeticCRS?.Name, d.GeodeticCRSName);
+                        Assert.AreEqual(crs.Datum?.Name, d.DatumName);
+                        Assert.AreEqual(crs.Ellipsoid?.Name, d.EllipsoidName);
+                        Assert.AreEqual(crs.Ellipsoid?.SemiMajorMetre ?? double.NaN, d.SemiMajorMetre);
+                        Assert.AreEqual(crs.PrimeMeridian?.Longitude ?? double.NaN, d.PrimeMeridianLongitude);
+                        Assert.AreEqual(crs.UsageArea?.Name, d.UsageAreaName);
+
+                        Assert.AreEqual(crs.AxisCount, d.AxisCount, $"Axis count of {crs.Name}");
+                        for (int n = 0; n < d.AxisCount; n++)
+                        {
+                            Assert.AreEqual(crs.Axis[n].Name, d.Axis[n].Name);
+                            Assert.AreEqual(crs.Axis[n].Direction, d.Axis[n].Direction);
+                            Assert.AreEqual(crs.Axis[n].UnitConversionFactor, d.Axis[n].UnitConversionFactor);
+                        }
+                    }
+                }
+                finally
+                {
+                    foreach (var c in a.Concat(b))
+                        c?.Dispose();
+                }
+            }
+        }
+
+        [TestMethod]
+        public void CachedExports()
+        {
+            const int n = 10000;
+            using (var pc = new ProjContext())
+            using (var crs = CoordinateReferenceSystem.CreateFromEpsg(28992, pc))
+            {
+                string wkt = crs.AsWellKnownText();
+                Assert.AreSame(wkt, crs.AsWellKnownText());
+                Assert.AreSame(wkt, crs.AsWellKnownText(new WktOptions()));
+                Assert.AreNotEqual(wkt, crs.AsWellKnownText(new WktOptions { SingleLine = true }));
+                Assert.AreNotEqual(wkt, crs.AsWellKnownText(new WktOptions { WktType = WktType.WKT1_GDAL }));
+                Assert.AreSame(crs.AsProjJson(), crs.AsProjJson());
+                StringAssert.StartsWith(crs.AsProjString(), "+proj=sterea ");
+
+                using (var ms = new MemoryStream())
+                {
+                    crs.WriteProjJson(ms, new ProjJsonOptions { NoMultiLine = true });
+                    Assert.AreEqual(crs.AsProjJson(new ProjJsonOptions { NoMultiLine = true }), Encoding.UTF8.GetString(ms.ToArray()));
+                }
+
+                byte[] utf8 = Encoding.UTF8.GetBytes(wkt);
+                IntPtr buffer = Marshal.AllocHGlobal(utf8.Length);
+                try
+                {
+                    Assert.IsFalse(crs.TryWriteWellKnownText(buffer, 10, out var required));
+                    Assert.AreEqual(utf8.Length, required);
+
+                    Assert.IsTrue(crs.TryWriteWellKnownText(buffer, utf8.Length, out var written));
+                    Assert.AreEqual(utf8.Length, written);
+
+                    byte[] copy = new byte[written];
+                    Marshal.Copy(buffer, copy, 0, written);
+                    CollectionAssert.AreEqual(utf8, copy);
+                }
+                finally
+                {
+                    Marshal.FreeHGlobal(buffer);
+                }
+
+                var options = new WktOptions { SingleLine = true };
+                var sw = Stopwatch.StartNew();
+                for (int i = 0; i < n; i++)
+                {
+                    using (var ms = new MemoryStream())
+                        crs.WriteWellKnownText(ms, options);
+                }
+                sw.Stop();
+                TestContext.WriteLine($"WriteWellKnownText: {sw.Elapsed.TotalMilliseconds * 1000.0 / n:F2} us");
+            }
+        }
+
+        [TestMethod]
+        public void BatchThroughput()
+        {
+            const int n = 1000000;
+
+            using (var pc = new ProjContext())
+            using (var wgs84 = CoordinateReferenceSystem.CreateFromEpsg(4326, pc))
+            using (var utm31 = CoordinateReferenceSystem.CreateFromEpsg(32631, pc))
+            using (var t = CoordinateTransform.Create(wgs84, utm31, pc))
+            {
+                var rnd = new Random(49);
+                var lat = new double[n];
+                var lon = new double[n];
+                var xy = new double[n, 2];
+                var xyz = new double[n, 3];
+
+                for (int i = 0; i < n; i++)
+                {
+                    xy[i, 0] = xyz[i, 0] = lat[i] = 40 + rnd.NextDouble() * 20;
+                    xy[i, 1] = xyz[i, 1] = lon[i] = rnd.NextDouble() * 6;
+                    xyz[i, 2] = 10;
+                }
+
+                void Report(string name, Action action, int count)
+                {
+                    action(); // Warm up, sets up the native fast path
+                    var sw = Stopwatch.StartNew();
+                    action();
+                    sw.Stop();
+                    TestContext.WriteLine($"{name}: {count / sw.Elapsed.TotalSeconds / 1e6:F2} M points/s");
+                }
+
+                var xs = new double[n];
+                var ys = new double[n];
+                var xy2 = new double[n, 2];
+                var xyz2 = new double[n, 3];
+
+                TestContext.WriteLine($"Native fast path: {t.HasFastPath}");
+                Report("Apply(PPoint)", () =>
+                {
+                    for (int i = 0; i < n / 10; i++)
+                        t.Apply(new PPoint(lat[i], lon[i]));
+                }, n / 10);
+                Report("Apply(x[], y[])", () =>
+                {
+                    Array.Copy(lat, xs, n);
+                    Array.Copy(lon, ys, n);
+                    t.Apply(xs, ys);
+                }, n);
+                Report("Apply(double[n, 2])", () =>
+                {
+                    Array.Copy(xy, xy2, xy.Length);
+                    t.Apply(xy2);
+                }, n);
+                Report("Apply(double[n, 3])", () =>
+                {
+                    Array.Copy(xyz, xyz2, xyz.Length);
+                    t.Apply(xyz2);
+                }, n);
+
+                for (int i = 0; i < n; i += 997)
+                {
+                    Assert.AreEqual(xs[i], xy2[i, 0]);
+                    Assert.AreEqual(ys[i], xy2[i, 1]);
+                    Assert.AreEqual(xs[i], xyz2[i, 0]);
+                    Assert.AreEqual(ys[i], xyz2[i, 1]);
+                    Assert.AreEqual(10, xyz2[i, 2]);
+                }
+
+                var route = Enumerable.Range(0, n / 10).Select(i => new PPoint(xs[i], ys[i])).ToArray();
+                Report("GeoDistance", () => utm31.DistanceTransform.GeoDistance(route), route.Length);
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.IO;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using NetTopologySuite.Geometries;
@@ -70,6 +71,65 @@ namespace SharpProj.Tests
             }
         }
 
+        [TestMethod]
+        public void Snapshot()
+        {
+            byte[] data;
+            using (var ms = new MemoryStream())
+            {
+                SridRegister.SaveSnapshot(ms);
+                data = ms.ToArray();
+            }
+            Assert.IsTrue(data.Length > 100);
+
+            // Everything is already registered in this process
+            using (var ms = new MemoryStream(data))
+                Assert.AreEqual(0, SridRegister.LoadSnapshot(ms));
+
+            Assert.AreEqual((int)Epsg.Netherlands, SridRegister.GetById(Epsg.Netherlands).SRID);
+            Assert.IsTrue(SridRegister.GetById(Epsg.Netherlands).IsCRSCreated);
+
+            using (var ms = new MemoryStream(new byte[] { 1, 2, 3, 4, 5, 6, 7, 8 }))
+                Assert.ThrowsException<InvalidDataException>(() => SridRegister.LoadSnapshot(ms));
+        }
+
+        [TestMethod]
+        public void SnapshotIsLazy()
+        {
+            const int sridNZ = 1902193;
+            const int sridFI = 1903067;
+            byte[] data;
+
+            // A snapshot with SRIDs that are not registered yet
+            using (var nzCrs = CoordinateReferenceSystem.CreateFromEpsg(2193))
+            using (var fiCrs = CoordinateReferenceSystem.CreateFromEpsg(3067))
+            using (var ms = new MemoryStream())
+            {
+                SridRegister.SaveSnapshot(ms, new Dictionary<int, CoordinateReferenceSystem> { [sridNZ] = nzCrs, [sridFI] = fiCrs });
+                data = ms.ToArray();
+            }
+
+            using (var ms = new MemoryStream(data))
+                Assert.AreEqual(2, SridRegister.LoadSnapshot(ms));
+
+            var nz = SridRegister.GetByValue(sridNZ);
+            var fi = SridRegister.GetByValue(sridFI);
+            Assert.IsFalse(nz.IsCRSCreated);
+            Assert.IsFalse(fi.IsCRSCreated);
+
+            // Loading again skips the registered SRIDs
+            using (var ms = new MemoryStream(data))
+                Assert.AreEqual(0, SridRegister.LoadSnapshot(ms));
+
+            Assert.IsFalse(nz.IsCRSCreated);
+            Assert.IsFalse(fi.IsCRSCreated);
+
+            // The CRS is created on first use
+            Assert.AreEqual("NZGD2000 / New Zealand Transverse Mercator 2000", nz.CRS.Name);
+            Assert.IsTrue(nz.IsCRSCreated);
+            Assert.IsFalse(fi.IsCRSCreated);
+        }
+
         [TestMethod, ExpectedException(typeof(ArgumentException))]
         public void NotSameTwice()
         {
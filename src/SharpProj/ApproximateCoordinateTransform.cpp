@@ -0,0 +1,388 @@
+#include "pch.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include "ApproximateCoordinateTransform.h"
+#include "ProjException.h"
+
+#pragma managed(push, off)
+struct approx_node
+{
+    int ix, iy, size; // Position and size on the lattice
+    int child;        // Index of the first of 4 children (low x/low y, high x/low y, low x/high y, high x/high y), or -1 for a leaf
+    bool exact;       // Leaf that is transformed exactly
+    double c[8];      // Target x, y of the corners (ix, iy), (ix+size, iy), (ix, iy+size) and (ix+size, iy+size)
+};
+
+// The cells of an approximation as a quadtree over a square lattice of n x n units, mapped on the source area
+struct approx_tree
+{
+    std::vector<approx_node> nodes;
+    double minX, minY, dx, dy;
+    int n;
+    int cells;
+
+    bool interpolate(double& x, double& y) const
+    {
+        double u = (x - minX) / dx;
+        double v = (y - minY) / dy;
+
+        if (!(u >= 0 && u <= n && v >= 0 && v <= n))
+            return false;
+
+        const approx_node* nd = &nodes[0];
+
+        while (nd->child >= 0)
+        {
+            int half = nd->size / 2;
+            nd = &nodes[nd->child + (u >= nd->ix + half ? 1 : 0) + (v >= nd->iy + half ? 2 : 0)];
+        }
+
+        if (nd->exact)
+            return false;
+
+        double s = (u - nd->ix) / nd->size;
+        double t = (v - nd->iy) / nd->size;
+
+        x = (1 - t) * ((1 - s) * nd->c[0] + s * nd->c[2]) + t * ((1 - s) * nd->c[4] + s * nd->c[6]);
+        y = (1 - t) * ((1 - s) * nd->c[1] + s * nd->c[3]) + t * ((1 - s) * nd->c[5] + s * nd->c[7]);
+        return true;
+    }
+};
+
+namespace {
+    const int APPROX_MIN_DEPTH = 2;
+    const int APPROX_MAX_DEPTH = 10;
+    const size_t APPROX_MAX_NODES = 1 << 18;
+    const int APPROX_CHECKS = 4; // Every cell is checked on a (APPROX_CHECKS + 1) x (APPROX_CHECKS + 1) lattice
+
+    // Interpolates all points it can in place and returns the indexes of the others
+    void approx_apply(const approx_tree& tree, double* xs, int xStep, double* ys, int yStep, int count, std::vector<int>& missed)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            double& x = xs[(size_t)i * xStep];
+            double& y = ys[(size_t)i * yStep];
+
+            if (!tree.interpolate(x, y))
+                missed.push_back(i);
+        }
+    }
+
+    // Builds the tree one level at a time. The points a level needs are handed out as one batch, which are then transformed
+    // in place by the caller. Cells are checked on a lattice of 5 x 5 points, so the corners and half of the checked points
+    // of child cells are already sampled by their parent.
+    class approx_builder
+    {
+    private:
+        approx_tree& m_tree;
+        double m_maxError;
+        std::unordered_map<uint64_t, size_t> m_index;
+        std::vector<double> m_x;
+        std::vector<double> m_y;
+        std::vector<int> m_level;
+        size_t m_firstPending;
+        int m_depth;
+
+        size_t sample(int ix, int iy)
+        {
+            uint64_t key = ((uint64_t)(uint32_t)ix << 32) | (uint32_t)iy;
+            auto it = m_index.find(key);
+
+            if (it != m_index.end())
+                return it->second;
+
+            size_t i = m_x.size();
+            m_x.push_back(m_tree.minX + ix * m_tree.dx);
+            m_y.push_back(m_tree.minY + iy * m_tree.dy);
+            m_index[key] = i;
+            return i;
+        }
+
+        bool sampled(size_t i, double& x, double& y) const
+        {
+            x = m_x[i];
+            y = m_y[i];
+            return std::isfinite(x) && std::isfinite(y);
+        }
+
+    public:
+        approx_builder(approx_tree& tree, double minX, double minY, double maxX, double maxY, double maxError)
+            : m_tree(tree)
+        {
+            m_maxError = maxError;
+            m_tree.n = APPROX_CHECKS << APPROX_MAX_DEPTH;
+            m_tree.minX = minX;
+            m_tree.minY = minY;
+            m_tree.dx = (maxX - minX) / m_tree.n;
+            m_tree.dy = (maxY - minY) / m_tree.n;
+            m_tree.cells = 0;
+
+            approx_node root = {};
+            root.size = m_tree.n;
+            root.child = -1;
+            m_tree.nodes.push_back(root);
+
+            m_level.push_back(0);
+            m_firstPending = 0;
+            m_depth = 0;
+        }
+
+        // Gets the points to transform for the current level, or false when the tree is complete
+        bool pending(double*& xs, double*& ys, int& count)
+        {
+            if (m_level.empty())
+                return false;
+
+            for (int idx : m_level)
+            {
+                const approx_node& nd = m_tree.nodes[idx];
+                int q = nd.size / APPROX_CHECKS;
+
+                for (int j = 0; j <= APPROX_CHECKS; j++)
+                {
+                    for (int i = 0; i <= APPROX_CHECKS; i++)
+                        sample(nd.ix + i * q, nd.iy + j * q);
+                }
+            }
+
+            xs = m_x.data() + m_firstPending;
+            ys = m_y.data() + m_firstPending;
+            count = (int)(m_x.size() - m_firstPending);
+            return true;
+        }
+
+        // Decides for every cell of the current level on the transformed points, whether it is a leaf or needs splitting
+        void evaluate()
+        {
+            std::vector<int> next;
+
+            m_firstPending = m_x.size();
+
+            for (int idx : m_level)
+            {
+                approx_node nd = m_tree.nodes[idx];
+                int s = nd.size, h = s / 2, q = s / APPROX_CHECKS;
+                double c[8];
+
+                bool ok = sampled(sample(nd.ix, nd.iy), c[0], c[1])
+                    && sampled(sample(nd.ix + s, nd.iy), c[2], c[3])
+                    && sampled(sample(nd.ix, nd.iy + s), c[4], c[5])
+                    && sampled(sample(nd.ix + s, nd.iy + s), c[6], c[7]);
+                bool anyValid = ok;
+
+                for (int j = 0; j <= APPROX_CHECKS; j++)
+                {
+                    for (int i = 0; i <= APPROX_CHECKS; i++)
+                    {
+                        double u = (double)i / APPROX_CHECKS, v = (double)j / APPROX_CHECKS;
+                        double x, y;
+
+                        if (!sampled(sample(nd.ix + i * q, nd.iy + j * q), x, y))
+                        {
+                            ok = false;
+                            continue;
+                        }
+
+                        anyValid = true;
+                        if (!ok)
+                            continue;
+
+                        double ix = (1 - v) * ((1 - u) * c[0] + u * c[2]) + v * ((1 - u) * c[4] + u * c[6]);
+                        double iy = (1 - v) * ((1 - u) * c[1] + u * c[3]) + v * ((1 - u) * c[5] + u * c[7]);
+
+                        if (std::hypot(ix - x, iy - y) > m_maxError)
+                            ok = false;
+                    }
+                }
+
+                // Nothing to interpolate in cells that are completely outside the domain of the transform
+                if (!anyValid)
+                {
+                    approx_node& ln = m_tree.nodes[idx];
+                    ln.exact = true;
+                    m_tree.cells++;
+                    continue;
+                }
+
+                bool leaf = ok && m_depth >= APPROX_MIN_DEPTH;
+
+                if (!leaf && m_depth < APPROX_MAX_DEPTH && m_tree.nodes.size() + 4 <= APPROX_MAX_NODES)
+                {
+                    int child = (int)m_tree.nodes.size();
+
+                    for (int k = 0; k < 4; k++)
+                    {
+                        approx_node cn = {};
+                        cn.ix = nd.ix + ((k & 1) ? h : 0);
+                        cn.iy = nd.iy + ((k & 2) ? h : 0);
+                        cn.size = h;
+                        cn.child = -1;
+                        m_tree.nodes.push_back(cn);
+                        next.push_back(child + k);
+                    }
+                    m_tree.nodes[idx].child = child;
+                }
+                else
+                {
+                    approx_node& ln = m_tree.nodes[idx];
+                    ln.exact = !leaf;
+
+                    for (int k = 0; k < 8; k++)
+                        ln.c[k] = c[k];
+
+                    m_tree.cells++;
+                }
+            }
+
+            // The samples of the next level follow the already transformed samples
+            m_firstPending = m_x.size();
+            m_level.swap(next);
+            m_depth++;
+        }
+    };
+}
+#pragma managed(pop)
+
+using namespace SharpProj;
+
+ApproximateCoordinateTransform^ CoordinateTransform::CreateApproximation(double minX, double minY, double maxX, double maxY, double maxError)
+{
+    if (!(maxError > 0))
+        throw gcnew ArgumentOutOfRangeException("maxError");
+    else if (!(minX < maxX) || !(minY < maxY) || double::IsInfinity(maxX - minX) || double::IsInfinity(maxY - minY))
+        throw gcnew ArgumentException("Invalid area");
+
+    PJ* pj = proj_clone(Context, this);
+
+    if (!pj)
+        throw Context->ConstructException();
+
+    ApproximateCoordinateTransform^ t = gcnew ApproximateCoordinateTransform(Context, pj, this);
+    try
+    {
+        t->Build(minX, minY, maxX, maxY, maxError);
+    }
+    catch (Exception^)
+    {
+        delete t;
+        throw;
+    }
+
+    return t;
+}
+
+ApproximateCoordinateTransform::!ApproximateCoordinateTransform()
+{
+    if (m_tree)
+    {
+        delete m_tree;
+        m_tree = nullptr;
+    }
+}
+
+ApproximateCoordinateTransform::~ApproximateCoordinateTransform()
+{
+    ApproximateCoordinateTransform::!ApproximateCoordinateTransform();
+}
+
+void ApproximateCoordinateTransform::Build(double minX, double minY, double maxX, double maxY, double maxError)
+{
+    m_maxError = maxError;
+    m_tree = new approx_tree();
+
+    approx_builder builder(*m_tree, minX, minY, maxX, maxY, maxError);
+    double* xs;
+    double* ys;
+    int count;
+
+    while (builder.pending(xs, ys, count))
+    {
+        if (count)
+            m_exact->TransformBoundsPoints(true, xs, ys, count);
+
+        builder.evaluate();
+    }
+
+    m_exact->Context->ClearError(m_exact);
+}
+
+int ApproximateCoordinateTransform::CellCount::get()
+{
+    return m_tree ? m_tree->cells : 0;
+}
+
+PPoint ApproximateCoordinateTransform::DoTransform(bool forward, PPoint% coordinate)
+{
+    if (!forward)
+        return m_exact->ApplyReversed(coordinate);
+
+    double x = coordinate.X;
+    double y = coordinate.Y;
+
+    if (m_tree && m_tree->interpolate(x, y))
+    {
+        PPoint r = coordinate;
+        r.X = x;
+        r.Y = y;
+        return r;
+    }
+
+    return m_exact->Apply(coordinate);
+}
+
+void ApproximateCoordinateTransform::DoTransform(bool forward,
+    double* xVals, int xStep, int xCount,
+    double* yVals, int yStep, int yCount,
+    double* zVals, int zStep, int zCount,
+    double* tVals, int tStep, int tCount)
+{
+    if (!forward || !m_tree || !xVals || !yVals || xCount < 1 || xCount != yCount)
+    {
+        // Reverse transforms and broadcast ordinates go to the exact transform
+        if (forward)
+            m_exact->Apply(xVals, xStep, xCount, yVals, yStep, yCount, zVals, zStep, zCount, tVals, tStep, tCount);
+        else
+            m_exact->ApplyReversed(xVals, xStep, xCount, yVals, yStep, yCount, zVals, zStep, zCount, tVals, tStep, tCount);
+        return;
+    }
+
+    std::vector<int> missed;
+    approx_apply(*m_tree, xVals, xStep, yVals, yStep, xCount, missed);
+
+    if (missed.empty())
+        return;
+
+    // Transform the remaining coordinates exactly in one call
+    int n = (int)missed.size();
+    bool zFull = zVals && zCount == xCount;
+    bool tFull = tVals && tCount == xCount;
+    std::vector<double> gx(n), gy(n), gz(zFull ? n : 0), gt(tFull ? n : 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        size_t j = missed[i];
+        gx[i] = xVals[j * xStep];
+        gy[i] = yVals[j * yStep];
+        if (zFull)
+            gz[i] = zVals[j * zStep];
+        if (tFull)
+            gt[i] = tVals[j * tStep];
+    }
+
+    m_exact->Apply(gx.data(), 1, n, gy.data(), 1, n,
+        zFull ? gz.data() : zVals, zFull ? 1 : zStep, zFull ? n : zCount,
+        tFull ? gt.data() : tVals, tFull ? 1 : tStep, tFull ? n : tCount);
+
+    for (int i = 0; i < n; i++)
+    {
+        size_t j = missed[i];
+        xVals[j * xStep] = gx[i];
+        yVals[j * yStep] = gy[i];
+        if (zFull)
+            zVals[j * zStep] = gz[i];
+        if (tFull)
+            tVals[j * tStep] = gt[i];
+    }
+}
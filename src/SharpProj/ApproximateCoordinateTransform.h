@@ -0,0 +1,74 @@
+#pragma once
+#include "CoordinateTransform.h"
+
+struct approx_tree;
+
+namespace SharpProj {
+
+    /// <summary>
+    /// Represents a <see cref="CoordinateTransform"/> that interpolates forward transforms inside an area, for workloads like
+    /// map rendering where the exact transform of every vertex is overkill. The exact transform is sampled on an adaptive grid
+    /// of cells, which are split until bilinear interpolation over a cell stays within the requested error on a lattice of
+    /// 5 x 5 check points per cell. The error between the check points is not guaranteed, so the requested error is a
+    /// best-effort bound. Coordinates outside the area, in cells that can't meet the error budget and all reverse transforms
+    /// use the exact transform.
+    /// </summary>
+    /// <remarks>Only X and Y are interpolated; Z and T of interpolated coordinates are passed through unchanged</remarks>
+    [DebuggerDisplay("[ApproximateCoordinateTransform] Cells={CellCount}, MaxError={MaxError}")]
+    public ref class ApproximateCoordinateTransform : CoordinateTransform
+    {
+    private:
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        initonly CoordinateTransform^ m_exact;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        approx_tree* m_tree;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        double m_maxError;
+
+    internal:
+        ApproximateCoordinateTransform(ProjContext^ ctx, PJ* pj, CoordinateTransform^ exact)
+            : CoordinateTransform(ctx, pj)
+        {
+            m_exact = exact;
+        }
+
+        void Build(double minX, double minY, double maxX, double maxY, double maxError);
+
+    private:
+        !ApproximateCoordinateTransform();
+        ~ApproximateCoordinateTransform();
+
+    protected:
+        virtual PPoint DoTransform(bool forward, PPoint% coordinate) override;
+        virtual void DoTransform(bool forward,
+            double* xVals, int xStep, int xCount,
+            double* yVals, int yStep, int yCount,
+            double* zVals, int zStep, int zCount,
+            double* tVals, int tStep, int tCount) override;
+
+    public:
+        /// <summary>
+        /// The transform used for coordinates that are not interpolated
+        /// </summary>
+        property CoordinateTransform^ ExactTransform
+        {
+            CoordinateTransform^ get() { return m_exact; }
+        }
+
+        /// <summary>
+        /// The maximum error in target units the approximation was created with
+        /// </summary>
+        property double MaxError
+        {
+            double get() { return m_maxError; }
+        }
+
+        /// <summary>
+        /// The number of interpolation cells
+        /// </summary>
+        property int CellCount
+        {
+            int get();
+        }
+    };
+}
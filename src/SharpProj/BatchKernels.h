@@ -0,0 +1,219 @@
+#pragma once
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <immintrin.h>
+#define BATCH_AVX2 1
+#elif defined(_M_ARM64)
+#include <arm_neon.h>
+#define BATCH_NEON 1
+#endif
+
+// Native helpers for the ordinate buffers of the batch APIs. On x86/x64 the AVX2 versions are selected at runtime, on ARM64
+// NEON is always available. Everything else (and the tails of the buffers) uses the scalar loops.
+#pragma managed(push, off)
+#if BATCH_AVX2
+inline bool batch_detect_avx2()
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) // OS saves the YMM registers
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+inline bool batch_has_avx2()
+{
+    static int avx2 = -1; // Benign race: every thread computes the same value
+
+    if (avx2 < 0)
+        avx2 = batch_detect_avx2() ? 1 : 0;
+
+    return avx2 != 0;
+}
+#endif
+
+// v[i] *= factor
+inline void batch_scale(double* v, size_t n, double factor)
+{
+    size_t i = 0;
+#if BATCH_AVX2
+    if (batch_has_avx2())
+    {
+        __m256d f = _mm256_set1_pd(factor);
+
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(v + i, _mm256_mul_pd(_mm256_loadu_pd(v + i), f));
+    }
+#elif BATCH_NEON
+    float64x2_t f = vdupq_n_f64(factor);
+
+    for (; i + 2 <= n; i += 2)
+        vst1q_f64(v + i, vmulq_f64(vld1q_f64(v + i), f));
+#endif
+    for (; i < n; i++)
+        v[i] *= factor;
+}
+
+// dst[i] = src[i * step]
+inline void batch_gather(const double* src, int step, size_t n, double* dst)
+{
+    size_t i = 0;
+
+    if (step == 1)
+    {
+        memcpy(dst, src, n * sizeof(double));
+        return;
+    }
+#if BATCH_AVX2
+    if (batch_has_avx2() && step > 1)
+    {
+        __m256i idx = _mm256_set_epi64x(3LL * step, 2LL * step, step, 0);
+
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_i64gather_pd(src + i * step, idx, 8));
+    }
+#elif BATCH_NEON
+    if (step == 2)
+    {
+        for (; i + 2 <= n; i += 2)
+            vst1q_f64(dst + i, vld2q_f64(src + 2 * i).val[0]);
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = src[i * step];
+}
+
+// dst[i * step] = src[i]
+inline void batch_scatter(const double* src, size_t n, double* dst, int step)
+{
+    if (step == 1)
+    {
+        memcpy(dst, src, n * sizeof(double));
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++)
+        dst[i * step] = src[i];
+}
+
+// Splits the first two ordinates of an interleaved buffer with 'stride' ordinates per coordinate
+inline void batch_deinterleave(const double* src, int stride, size_t n, double* x, double* y)
+{
+    size_t i = 0;
+#if BATCH_AVX2
+    if (batch_has_avx2())
+    {
+        if (stride == 2)
+        {
+            for (; i + 4 <= n; i += 4)
+            {
+                __m256d a = _mm256_loadu_pd(src + 2 * i);     // x0 y0 x1 y1
+                __m256d b = _mm256_loadu_pd(src + 2 * i + 4); // x2 y2 x3 y3
+
+                _mm256_storeu_pd(x + i, _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8));
+                _mm256_storeu_pd(y + i, _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8));
+            }
+        }
+        else if (stride > 2)
+        {
+            __m256i idx = _mm256_set_epi64x(3LL * stride, 2LL * stride, stride, 0);
+
+            for (; i + 4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(x + i, _mm256_i64gather_pd(src + i * stride, idx, 8));
+                _mm256_storeu_pd(y + i, _mm256_i64gather_pd(src + i * stride + 1, idx, 8));
+            }
+        }
+    }
+#elif BATCH_NEON
+    if (stride == 2)
+    {
+        for (; i + 2 <= n; i += 2)
+        {
+            float64x2x2_t v = vld2q_f64(src + 2 * i);
+            vst1q_f64(x + i, v.val[0]);
+            vst1q_f64(y + i, v.val[1]);
+        }
+    }
+    else if (stride == 3)
+    {
+        for (; i + 2 <= n; i += 2)
+        {
+            float64x2x3_t v = vld3q_f64(src + 3 * i);
+            vst1q_f64(x + i, v.val[0]);
+            vst1q_f64(y + i, v.val[1]);
+        }
+    }
+    else if (stride == 4)
+    {
+        for (; i + 2 <= n; i += 2)
+        {
+            float64x2x4_t v = vld4q_f64(src + 4 * i);
+            vst1q_f64(x + i, v.val[0]);
+            vst1q_f64(y + i, v.val[1]);
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        x[i] = src[i * stride];
+        y[i] = src[i * stride + 1];
+    }
+}
+
+// Stores x and y as the first two ordinates of an interleaved buffer, leaving the other ordinates untouched
+inline void batch_interleave(const double* x, const double* y, size_t n, double* dst, int stride)
+{
+    size_t i = 0;
+#if BATCH_AVX2
+    if (stride == 2 && batch_has_avx2())
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256d a = _mm256_loadu_pd(x + i);
+            __m256d b = _mm256_loadu_pd(y + i);
+            __m256d lo = _mm256_unpacklo_pd(a, b); // x0 y0 x2 y2
+            __m256d hi = _mm256_unpackhi_pd(a, b); // x1 y1 x3 y3
+
+            _mm256_storeu_pd(dst + 2 * i, _mm256_permute2f128_pd(lo, hi, 0x20));
+            _mm256_storeu_pd(dst + 2 * i + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+        }
+    }
+#elif BATCH_NEON
+    if (stride == 2)
+    {
+        for (; i + 2 <= n; i += 2)
+        {
+            float64x2x2_t v = { { vld1q_f64(x + i), vld1q_f64(y + i) } };
+            vst2q_f64(dst + 2 * i, v);
+        }
+    }
+    else if (stride == 4)
+    {
+        for (; i + 2 <= n; i += 2)
+        {
+            float64x2x4_t v = vld4q_f64(dst + 4 * i);
+            v.val[0] = vld1q_f64(x + i);
+            v.val[1] = vld1q_f64(y + i);
+            vst4q_f64(dst + 4 * i, v);
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        dst[i * stride] = x[i];
+        dst[i * stride + 1] = y[i];
+    }
+}
+#pragma managed(pop)
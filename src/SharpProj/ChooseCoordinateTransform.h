@@ -140,6 +140,14 @@ namespace SharpProj {
             }
         }
 
+        property bool HasFastPath
+        {
+            virtual bool get() override sealed
+            {
+                return false; // Coordinates are transformed one at a time
+            }
+        }
+
         property ProjType Type
         {
             virtual ProjType get() override
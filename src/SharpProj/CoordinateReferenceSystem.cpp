@@ -4,6 +4,8 @@
 #include "ProjContext.h"
 #include "ProjException.h"
 #include "CoordinateReferenceSystem.h"
+#include "CoordinateReferenceSystemCache.h"
+#include "ProjContextPool.h"
 #include "GeographicCRS.h"
 #include "DatumList.h"
 #include "CoordinateTransform.h"
@@ -259,7 +261,7 @@ CoordinateReferenceSystem^ CoordinateReferenceSystem::CreateFromDatabase(String^
     {
         std::string authStr = utf8_string(authority);
         std::string codeStr = utf8_string(code);
-        PJ* pj = proj_create_from_database(ctx, authStr.c_str(), codeStr.c_str(), PJ_CATEGORY_CRS, false, nullptr);
+        PJ* pj = CoordinateReferenceSystemCache::Create(ctx, authStr.c_str(), codeStr.c_str());
 
         if (!pj)
             throw ctx->ConstructException();
@@ -277,6 +279,119 @@ CoordinateReferenceSystem^ CoordinateReferenceSystem::CreateFromDatabase(String^
     }
 }
 
+private ref class CreateFromDatabaseBatch sealed
+{
+public:
+    System::Collections::Generic::IReadOnlyList<Identifier^>^ Identifiers;
+    System::Collections::Generic::List<int>^ Todo;
+    array<IntPtr>^ Created;
+    array<Exception^>^ Errors;
+
+    ProjContext^ Run(int t, System::Threading::Tasks::ParallelLoopState^ state, ProjContext^ ctx)
+    {
+        UNUSED_ALWAYS(state);
+        int i = Todo[t];
+        try
+        {
+            Identifier^ id = Identifiers[i];
+
+            if ((Object^)id == nullptr)
+                throw gcnew ArgumentNullException("identifiers");
+
+            // The cache is handled once for the whole batch, so the workers don't contend on its lock
+            std::string authStr = utf8_string(id->Authority);
+            std::string codeStr = utf8_string(id->Code);
+            PJ* pj = proj_create_from_database(ctx, authStr.c_str(), codeStr.c_str(), PJ_CATEGORY_CRS, false, nullptr);
+
+            if (!pj)
+                throw ctx->ConstructException();
+
+            Created[i] = IntPtr(pj);
+        }
+        catch (Exception^ ex)
+        {
+            Errors[i] = ex;
+        }
+        return ctx;
+    }
+};
+
+array<CoordinateReferenceSystem^>^ CoordinateReferenceSystem::CreateFromDatabase(System::Collections::Generic::IReadOnlyList<Proj::Identifier^>^ identifiers, [Out] array<Exception^>^% errors, ProjContext^ ctx)
+{
+    if (!identifiers)
+        throw gcnew ArgumentNullException("identifiers");
+    else if (!ctx)
+        throw gcnew ArgumentNullException("ctx");
+
+    int n = identifiers->Count;
+    CreateFromDatabaseBatch^ batch = gcnew CreateFromDatabaseBatch();
+    batch->Identifiers = identifiers;
+    batch->Created = gcnew array<IntPtr>(n);
+    batch->Errors = gcnew array<Exception^>(n);
+
+    array<CoordinateReferenceSystem^>^ result = gcnew array<CoordinateReferenceSystem^>(n);
+    array<String^>^ keys = gcnew array<String^>(n);
+
+    if (CoordinateReferenceSystemCache::Capacity > 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            Identifier^ id = identifiers[i];
+
+            if ((Object^)id != nullptr)
+                keys[i] = CoordinateReferenceSystemCache::GetKey(ctx, id->Authority, id->Code);
+        }
+    }
+
+    ProjContextPool^ pool = gcnew ProjContextPool(ctx);
+    try
+    {
+        // Cached definitions are created directly in ctx, only the rest is read from the database
+        CoordinateReferenceSystemCache::Lookup(ctx, keys, batch->Created);
+
+        batch->Todo = gcnew System::Collections::Generic::List<int>();
+        for (int i = 0; i < n; i++)
+        {
+            if (batch->Created[i] == IntPtr::Zero)
+                batch->Todo->Add(i);
+        }
+
+        System::Threading::Tasks::Parallel::For(0, batch->Todo->Count,
+            gcnew Func<ProjContext^>(pool, &ProjContextPool::Rent),
+            gcnew Func<int, System::Threading::Tasks::ParallelLoopState^, ProjContext^, ProjContext^>(batch, &CreateFromDatabaseBatch::Run),
+            gcnew Action<ProjContext^>(pool, &ProjContextPool::Return));
+
+        CoordinateReferenceSystemCache::Add(keys, batch->Created, batch->Todo);
+
+        // Move the results to the requested context, while the worker contexts still exist
+        for (int i = 0; i < n; i++)
+        {
+            PJ* pj = (PJ*)(void*)batch->Created[i];
+
+            if (pj)
+            {
+                batch->Created[i] = IntPtr::Zero;
+                proj_assign_context(pj, ctx);
+                result[i] = ctx->Create<CoordinateReferenceSystem^>(pj);
+            }
+        }
+    }
+    finally
+    {
+        for (int i = 0; i < n; i++)
+        {
+            PJ* pj = (PJ*)(void*)batch->Created[i];
+
+            if (pj)
+                proj_destroy(pj);
+        }
+        delete pool;
+    }
+
+    errors = batch->Errors;
+    return result;
+}
+
 Proj::GeodeticCRS^ CoordinateReferenceSystem::GeodeticCRS::get()
 {
     if (!m_geodCRS && this)
@@ -20,6 +20,7 @@ namespace SharpProj {
 
         ref class CoordinateSystem;
         ref class UsageArea;
+        ref class CoordinateReferenceSystemDescription;
     }
 
     ref class CoordinateReferenceIdList;
@@ -57,6 +58,8 @@ namespace SharpProj {
         int m_axis;
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         CoordinateReferenceSystem^ m_from;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        CoordinateReferenceSystemDescription^ m_description;
 
         ~CoordinateReferenceSystem();
 
@@ -141,6 +144,13 @@ namespace SharpProj {
             CoordinateTransform^ get();
         }
 
+        /// <summary>
+        /// Gets the name, datum, ellipsoid, prime meridian, axis and usage area information of this coordinate reference system
+        /// in a single call, without creating the intermediate <see cref="Proj::Datum"/>, <see cref="Proj::Ellipsoid"/>,
+        /// <see cref="Proj::CoordinateSystem"/>, ... objects. The result is cached.
+        /// </summary>
+        Proj::CoordinateReferenceSystemDescription^ Describe();
+
         CoordinateReferenceSystem^ PromotedTo3D();
         CoordinateReferenceSystem^ DemotedTo2D();
 
@@ -213,5 +223,16 @@ namespace SharpProj {
 
             return CreateFromDatabase(identifier->Authority, identifier->Code, ctx);
         }
+
+        /// <summary>
+        /// Creates the coordinate reference systems for all identifiers at once. The <see cref="CoordinateReferenceSystemCache" />
+        /// is consulted once for the whole batch and the remaining database lookups run in parallel on clones of
+        /// <paramref name="ctx" />; the results are all created in <paramref name="ctx" />.
+        /// </summary>
+        /// <param name="identifiers">Identifiers of the coordinate reference systems to create</param>
+        /// <param name="errors">Receives per identifier the exception that occurred while creating it, or null on success</param>
+        /// <param name="ctx">Context to create the coordinate reference systems in</param>
+        /// <returns>Per identifier the created coordinate reference system, or null on failure</returns>
+        static array<CoordinateReferenceSystem^>^ CreateFromDatabase(System::Collections::Generic::IReadOnlyList<Proj::Identifier^>^ identifiers, [Out] array<Exception^>^% errors, ProjContext^ ctx);
     };
 }
@@ -0,0 +1,210 @@
+#include "pch.h"
+#include "ProjContext.h"
+#include "CoordinateReferenceSystemCache.h"
+
+using System::Threading::Monitor;
+using System::Collections::Generic::LinkedListNode;
+
+PJ* CoordinateReferenceSystemCache::Create(ProjContext^ ctx, const char* authority, const char* code)
+{
+    if (s_capacity <= 0)
+        return proj_create_from_database(ctx, authority, code, PJ_CATEGORY_CRS, false, nullptr);
+
+    String^ key = GetKey(ctx, Utf8_PtrToString(authority), Utf8_PtrToString(code));
+
+    Monitor::Enter(s_lock);
+    try
+    {
+        LinkedListNode<Entry^>^ node;
+
+        if (s_entries->TryGetValue(key, node))
+        {
+            s_lru->Remove(node);
+            s_lru->AddFirst(node);
+            s_hits++;
+
+            return proj_clone(ctx, (PJ*)(void*)node->Value->Master);
+        }
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+
+    PJ* pj = proj_create_from_database(ctx, authority, code, PJ_CATEGORY_CRS, false, nullptr);
+
+    if (!pj)
+        return nullptr;
+
+    Monitor::Enter(s_lock);
+    try
+    {
+        s_misses++;
+
+        if (!s_entries->ContainsKey(key) && s_capacity > 0)
+        {
+            if (!s_ctx)
+                s_ctx = gcnew ProjContext();
+
+            PJ* master = proj_clone(s_ctx, pj);
+
+            if (master)
+            {
+                Entry^ e = gcnew Entry();
+                e->Key = key;
+                e->Master = IntPtr(master);
+
+                s_entries[key] = s_lru->AddFirst(e);
+                Trim(s_capacity);
+            }
+            else
+                s_ctx->ClearError();
+        }
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+
+    return pj;
+}
+
+String^ CoordinateReferenceSystemCache::GetKey(ProjContext^ ctx, String^ authority, String^ code)
+{
+    // Different contexts may use different databases
+    const char* db = proj_context_get_database_path(ctx);
+    return String::Concat(Utf8_PtrToString(db), "\n", authority, ":", code);
+}
+
+// Batch version of the lookup in Create(). Creates the cached definitions in ctx, leaving the misses zero
+void CoordinateReferenceSystemCache::Lookup(ProjContext^ ctx, array<String^>^ keys, array<IntPtr>^ created)
+{
+    Monitor::Enter(s_lock);
+    try
+    {
+        for (int i = 0; i < keys->Length; i++)
+        {
+            LinkedListNode<Entry^>^ node;
+
+            if (!keys[i] || !s_entries->TryGetValue(keys[i], node))
+                continue;
+
+            PJ* pj = proj_clone(ctx, (PJ*)(void*)node->Value->Master);
+
+            if (!pj)
+            {
+                ctx->ClearError();
+                continue;
+            }
+
+            s_lru->Remove(node);
+            s_lru->AddFirst(node);
+            s_hits++;
+            created[i] = IntPtr(pj);
+        }
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
+
+// Batch version of the insert in Create(), for the definitions at indexes that were read from the database
+void CoordinateReferenceSystemCache::Add(array<String^>^ keys, array<IntPtr>^ created, System::Collections::Generic::IList<int>^ indexes)
+{
+    Monitor::Enter(s_lock);
+    try
+    {
+        for each (int i in indexes)
+        {
+            PJ* pj = (PJ*)(void*)created[i];
+
+            if (!pj || !keys[i])
+                continue;
+
+            s_misses++;
+
+            if (s_capacity <= 0 || s_entries->ContainsKey(keys[i]))
+                continue;
+
+            if (!s_ctx)
+                s_ctx = gcnew ProjContext();
+
+            PJ* master = proj_clone(s_ctx, pj);
+
+            if (master)
+            {
+                Entry^ e = gcnew Entry();
+                e->Key = keys[i];
+                e->Master = IntPtr(master);
+
+                s_entries[keys[i]] = s_lru->AddFirst(e);
+            }
+            else
+                s_ctx->ClearError();
+        }
+
+        Trim(s_capacity);
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
+
+void CoordinateReferenceSystemCache::Trim(int capacity)
+{
+    while (s_lru->Count > capacity)
+    {
+        Entry^ e = s_lru->Last->Value;
+        s_lru->RemoveLast();
+        s_entries->Remove(e->Key);
+
+        proj_destroy((PJ*)(void*)e->Master);
+    }
+}
+
+void CoordinateReferenceSystemCache::Capacity::set(int value)
+{
+    if (value < 0)
+        throw gcnew ArgumentOutOfRangeException("value");
+
+    Monitor::Enter(s_lock);
+    try
+    {
+        s_capacity = value;
+        Trim(value);
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
+
+int CoordinateReferenceSystemCache::Count::get()
+{
+    Monitor::Enter(s_lock);
+    try
+    {
+        return s_lru->Count;
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
+
+void CoordinateReferenceSystemCache::Clear()
+{
+    Monitor::Enter(s_lock);
+    try
+    {
+        Trim(0);
+        s_hits = 0;
+        s_misses = 0;
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+namespace SharpProj {
+    ref class CoordinateReferenceSystem;
+
+    /// <summary>
+    /// Process wide cache of coordinate reference system definitions created from the database via
+    /// <see cref="CoordinateReferenceSystem::CreateFromDatabase(String^, String^, ProjContext^)"/>. Definitions are
+    /// immutable, so a cached definition is shared by all contexts and each call only creates a cheap handle
+    /// in the requested context.
+    /// </summary>
+    public ref class CoordinateReferenceSystemCache abstract sealed
+    {
+    private:
+        ref class Entry sealed
+        {
+        public:
+            String^ Key;
+            IntPtr Master;
+        };
+
+        static initonly Object^ s_lock = gcnew Object();
+        static initonly System::Collections::Generic::Dictionary<String^, System::Collections::Generic::LinkedListNode<Entry^>^>^ s_entries
+            = gcnew System::Collections::Generic::Dictionary<String^, System::Collections::Generic::LinkedListNode<Entry^>^>(StringComparer::Ordinal);
+        static initonly System::Collections::Generic::LinkedList<Entry^>^ s_lru = gcnew System::Collections::Generic::LinkedList<Entry^>();
+        static ProjContext^ s_ctx;
+        static int s_capacity = 256;
+        static __int64 s_hits;
+        static __int64 s_misses;
+
+        static void Trim(int capacity);
+
+    internal:
+        static PJ* Create(ProjContext^ ctx, const char* authority, const char* code);
+        static String^ GetKey(ProjContext^ ctx, String^ authority, String^ code);
+        static void Lookup(ProjContext^ ctx, array<String^>^ keys, array<IntPtr>^ created);
+        static void Add(array<String^>^ keys, array<IntPtr>^ created, System::Collections::Generic::IList<int>^ indexes);
+
+    public:
+        /// <summary>
+        /// Gets or sets the maximum number of cached definitions. Defaults to 256. Set to 0 to disable caching.
+        /// </summary>
+        static property int Capacity
+        {
+            int get()
+            {
+                return s_capacity;
+            }
+            void set(int value);
+        }
+
+        /// <summary>
+        /// Gets the number of definitions currently cached
+        /// </summary>
+        static property int Count
+        {
+            int get();
+        }
+
+        /// <summary>
+        /// Gets the number of requests that were answered from the cache
+        /// </summary>
+        static property __int64 Hits
+        {
+            __int64 get()
+            {
+                return System::Threading::Interlocked::Read(s_hits);
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of requests that had to be answered from the database
+        /// </summary>
+        static property __int64 Misses
+        {
+            __int64 get()
+            {
+                return System::Threading::Interlocked::Read(s_misses);
+            }
+        }
+
+        /// <summary>
+        /// Removes all cached definitions and resets the counters
+        /// </summary>
+        static void Clear();
+    };
+}
@@ -0,0 +1,852 @@
+#include "pch.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "ProjObject.h"
+#include "CoordinateReferenceSystemCatalog.h"
+
+using System::Threading::Monitor;
+using System::Collections::Generic::List;
+using System::Collections::Generic::HashSet;
+
+#pragma managed(push, off)
+// Splits a longitude range into at most two ranges that don't cross the antimeridian
+static int lon_ranges(double west, double east, double ranges[4])
+{
+    if (west <= east)
+    {
+        ranges[0] = west;
+        ranges[1] = east;
+        return 1;
+    }
+
+    ranges[0] = west;
+    ranges[1] = 180.0;
+    ranges[2] = -180.0;
+    ranges[3] = east;
+    return 2;
+}
+
+// Matches the area of use of a crs (west, south, east, north) against an area, like proj_get_crs_info_list_from_database()
+static bool bbox_matches(const double* crs, double west, double south, double east, double north, bool contains)
+{
+    if (crs[0] != crs[0])
+        return false; // NaN: No area of use
+
+    double c[4], a[4];
+    int nc = lon_ranges(crs[0], crs[2], c);
+    int na = lon_ranges(west, east, a);
+
+    if (contains)
+    {
+        if (south < crs[1] || north > crs[3])
+            return false;
+
+        for (int i = 0; i < na; i++)
+        {
+            bool inside = false;
+            for (int j = 0; j < nc && !inside; j++)
+                inside = (a[2 * i] >= c[2 * j] && a[2 * i + 1] <= c[2 * j + 1]);
+
+            if (!inside)
+                return false;
+        }
+        return true;
+    }
+    else
+    {
+        if (crs[3] < south || crs[1] > north)
+            return false;
+
+        for (int i = 0; i < na; i++)
+            for (int j = 0; j < nc; j++)
+                if (c[2 * j + 1] >= a[2 * i] && c[2 * j] <= a[2 * i + 1])
+                    return true;
+
+        return false;
+    }
+}
+
+// Static R-tree over the areas of use, packed with the Sort-Tile-Recursive algorithm. Areas crossing the antimeridian
+// are stored as two boxes referring to the same item
+struct crs_rtree
+{
+    static const int fanout = 16;
+
+    struct node
+    {
+        double box[4]; // west, south, east, north
+        int first;     // Leaf: item. Otherwise: first child node
+        int count;     // 0 for leafs
+    };
+
+    std::vector<node> nodes;
+    int root = -1;
+
+    void add(int item, double west, double south, double east, double north)
+    {
+        node n = { { west, south, east, north }, item, 0 };
+        nodes.push_back(n);
+    }
+
+    void build()
+    {
+        if (nodes.empty())
+            return;
+
+        size_t start = 0;
+        size_t end = nodes.size();
+
+        while (true)
+        {
+            pack(start, end);
+
+            if (end - start == 1)
+                break;
+
+            // Create the parents of this level
+            for (size_t i = start; i < end; i += fanout)
+            {
+                size_t last = (i + fanout < end) ? i + fanout : end;
+                node p = { { nodes[i].box[0], nodes[i].box[1], nodes[i].box[2], nodes[i].box[3] }, (int)i, (int)(last - i) };
+
+                for (size_t j = i + 1; j < last; j++)
+                {
+                    p.box[0] = (std::min)(p.box[0], nodes[j].box[0]);
+                    p.box[1] = (std::min)(p.box[1], nodes[j].box[1]);
+                    p.box[2] = (std::max)(p.box[2], nodes[j].box[2]);
+                    p.box[3] = (std::max)(p.box[3], nodes[j].box[3]);
+                }
+                nodes.push_back(p);
+            }
+
+            start = end;
+            end = nodes.size();
+        }
+
+        root = (int)start;
+    }
+
+    // Collects the items of all boxes intersecting the (non antimeridian crossing) box
+    void query(double west, double south, double east, double north, std::vector<int>& items) const
+    {
+        if (root < 0)
+            return;
+
+        std::vector<int> stack;
+        stack.push_back(root);
+
+        while (!stack.empty())
+        {
+            const node& n = nodes[stack.back()];
+            stack.pop_back();
+
+            if (n.box[2] < west || n.box[0] > east || n.box[3] < south || n.box[1] > north)
+                continue;
+            else if (!n.count)
+                items.push_back(n.first);
+            else
+            {
+                for (int i = 0; i < n.count; i++)
+                    stack.push_back(n.first + i);
+            }
+        }
+    }
+
+private:
+    // Orders the nodes in [start, end) in vertical slices of tiles, sorted by their centers
+    void pack(size_t start, size_t end)
+    {
+        size_t count = end - start;
+        size_t pages = (count + fanout - 1) / fanout;
+        size_t slices = (size_t)std::ceil(std::sqrt((double)pages));
+        size_t perSlice = slices * fanout;
+
+        auto first = nodes.begin() + start;
+        std::sort(first, first + count,
+            [](const node& a, const node& b) { return a.box[0] + a.box[2] < b.box[0] + b.box[2]; });
+
+        for (size_t i = 0; i < count; i += perSlice)
+        {
+            size_t last = (i + perSlice < count) ? i + perSlice : count;
+
+            std::sort(first + i, first + last,
+                [](const node& a, const node& b) { return a.box[1] + a.box[3] < b.box[1] + b.box[3]; });
+        }
+    }
+};
+#pragma managed(pop)
+
+private ref class CatalogItemComparer : System::Collections::Generic::IComparer<int>
+{
+    initonly array<CoordinateReferenceSystemInfo^>^ m_items;
+    initonly array<int>^ m_codes;
+    initonly array<bool>^ m_numeric;
+
+public:
+    CatalogItemComparer(array<CoordinateReferenceSystemInfo^>^ items)
+    {
+        m_items = items;
+        m_codes = gcnew array<int>(items->Length);
+        m_numeric = gcnew array<bool>(items->Length);
+
+        // Parse the codes once, instead of on every comparison
+        for (int i = 0; i < items->Length; i++)
+            m_numeric[i] = int::TryParse(items[i]->Code, m_codes[i]);
+    }
+
+    virtual int Compare(int x, int y)
+    {
+        int n = StringComparer::OrdinalIgnoreCase->Compare(m_items[x]->Authority, m_items[y]->Authority);
+        if (n != 0)
+            return n;
+
+        if (m_numeric[x] && m_numeric[y])
+        {
+            n = m_codes[x] - m_codes[y];
+
+            if (n != 0)
+                return n;
+        }
+
+        n = StringComparer::OrdinalIgnoreCase->Compare(m_items[x]->Name, m_items[y]->Name);
+        if (n != 0)
+            return n;
+
+        return x - y;
+    }
+};
+
+private ref class CatalogNameComparer : System::Collections::Generic::IComparer<int>
+{
+    initonly array<CoordinateReferenceSystemInfo^>^ m_items;
+
+public:
+    CatalogNameComparer(array<CoordinateReferenceSystemInfo^>^ items)
+    {
+        m_items = items;
+    }
+
+    virtual int Compare(int x, int y)
+    {
+        int n = StringComparer::OrdinalIgnoreCase->Compare(m_items[x]->Name, m_items[y]->Name);
+
+        return n ? n : (x - y);
+    }
+};
+
+static void AddToIndex(Dictionary<String^, List<int>^>^ index, String^ key, int item)
+{
+    if (!key)
+        return;
+
+    List<int>^ lst;
+    if (!index->TryGetValue(key, lst))
+        index->Add(key, lst = gcnew List<int>());
+
+    lst->Add(item);
+}
+
+CoordinateReferenceSystemCatalog::CoordinateReferenceSystemCatalog(ProjContext^ ctx)
+{
+    PROJ_CRS_LIST_PARAMETERS* params = proj_get_crs_list_parameters_create();
+    array<CoordinateReferenceSystemInfo^>^ items;
+
+    try
+    {
+        params->allow_deprecated = true;
+
+        int count;
+        PROJ_CRS_INFO** infoList = proj_get_crs_info_list_from_database(ctx, nullptr, params, &count);
+
+        if (!infoList)
+            throw ctx->ConstructException("GetCoordinateReferenceSystems");
+
+        try
+        {
+            items = gcnew array<CoordinateReferenceSystemInfo^>(count);
+
+            for (int i = 0; i < count; i++)
+                items[i] = gcnew CoordinateReferenceSystemInfo(infoList[i], nullptr);
+        }
+        finally
+        {
+            proj_crs_info_list_destroy(infoList);
+        }
+    }
+    finally
+    {
+        proj_get_crs_list_parameters_destroy(params);
+    }
+
+    // Sort once
+    array<int>^ order = gcnew array<int>(items->Length);
+    for (int i = 0; i < order->Length; i++)
+        order[i] = i;
+
+    Array::Sort(order, gcnew CatalogItemComparer(items));
+
+    m_items = gcnew array<CoordinateReferenceSystemInfo^>(items->Length);
+    m_bbox = gcnew array<double>(4 * items->Length);
+
+    auto byAuthority = gcnew Dictionary<String^, List<int>^>(StringComparer::Ordinal);
+    auto byBody = gcnew Dictionary<String^, List<int>^>(StringComparer::Ordinal);
+    auto byType = gcnew Dictionary<ProjType, List<int>^>();
+
+    for (int i = 0; i < order->Length; i++)
+    {
+        CoordinateReferenceSystemInfo^ info = items[order[i]];
+        m_items[i] = info;
+
+        ProjArea^ bbox = info->BoundingBox;
+        if (bbox)
+        {
+            m_bbox[4 * i + 0] = bbox->WestLongitude;
+            m_bbox[4 * i + 1] = bbox->SouthLatitude;
+            m_bbox[4 * i + 2] = bbox->EastLongitude;
+            m_bbox[4 * i + 3] = bbox->NorthLatitude;
+        }
+        else
+        {
+            m_bbox[4 * i + 0] = m_bbox[4 * i + 1] = m_bbox[4 * i + 2] = m_bbox[4 * i + 3] = double::NaN;
+        }
+
+        AddToIndex(byAuthority, info->Authority, i);
+        AddToIndex(byBody, info->CelestialBodyName, i);
+
+        List<int>^ lst;
+        if (!byType->TryGetValue(info->Type, lst))
+            byType->Add(info->Type, lst = gcnew List<int>());
+        lst->Add(i);
+    }
+
+    m_byAuthority = gcnew Dictionary<String^, array<int>^>(byAuthority->Count, StringComparer::Ordinal);
+    for each (auto kv in byAuthority)
+        m_byAuthority->Add(kv.Key, kv.Value->ToArray());
+
+    m_byBody = gcnew Dictionary<String^, array<int>^>(byBody->Count, StringComparer::Ordinal);
+    for each (auto kv in byBody)
+        m_byBody->Add(kv.Key, kv.Value->ToArray());
+
+    m_byType = gcnew Dictionary<ProjType, array<int>^>(byType->Count);
+    for each (auto kv in byType)
+        m_byType->Add(kv.Key, kv.Value->ToArray());
+
+    m_area = gcnew array<double>(m_items->Length);
+    m_rtree = new crs_rtree();
+
+    for (int i = 0; i < m_items->Length; i++)
+    {
+        double west = m_bbox[4 * i + 0];
+        double south = m_bbox[4 * i + 1];
+        double east = m_bbox[4 * i + 2];
+        double north = m_bbox[4 * i + 3];
+
+        if (double::IsNaN(west))
+        {
+            m_area[i] = double::PositiveInfinity;
+            continue;
+        }
+
+        double range[4];
+        int n = lon_ranges(west, east, range);
+
+        for (int r = 0; r < n; r++)
+            m_rtree->add(i, range[2 * r], south, range[2 * r + 1], north);
+
+        // Proportional to the area on the sphere
+        double width = (west <= east) ? (east - west) : (east - west + 360.0);
+        m_area[i] = width * (Math::Sin(north * Math::PI / 180.0) - Math::Sin(south * Math::PI / 180.0));
+    }
+    m_rtree->build();
+
+    m_byName = gcnew array<int>(m_items->Length);
+    for (int i = 0; i < m_byName->Length; i++)
+        m_byName[i] = i;
+
+    Array::Sort(m_byName, gcnew CatalogNameComparer(m_items));
+}
+
+CoordinateReferenceSystemCatalog::!CoordinateReferenceSystemCatalog()
+{
+    if (m_rtree)
+    {
+        delete m_rtree;
+        m_rtree = nullptr;
+    }
+}
+
+CoordinateReferenceSystemCatalog^ CoordinateReferenceSystemCatalog::Get(ProjContext^ ctx)
+{
+    // The same database file may be updated, so also include the versions it contains
+    String^ key = Utf8_PtrToString(proj_context_get_database_path(ctx));
+
+    static const char* const versionKeys[] = { "EPSG.VERSION", "EPSG.DATE", "ESRI.VERSION", "IGNF.VERSION" };
+    for (const char* md : versionKeys)
+        key += "\n" + Utf8_PtrToString(proj_context_get_database_metadata(ctx, md));
+
+    Monitor::Enter(s_lock);
+    try
+    {
+        CoordinateReferenceSystemCatalog^ catalog;
+
+        if (!s_catalogs->TryGetValue(key, catalog))
+        {
+            catalog = gcnew CoordinateReferenceSystemCatalog(ctx);
+            s_catalogs[key] = catalog;
+        }
+
+        return catalog;
+    }
+    finally
+    {
+        Monitor::Exit(s_lock);
+    }
+}
+
+array<int>^ CoordinateReferenceSystemCatalog::NameRange(String^ prefix)
+{
+    int lo = 0, hi = m_byName->Length;
+
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if (StringComparer::OrdinalIgnoreCase->Compare(m_items[m_byName[mid]]->Name, prefix) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    int end = lo;
+    while (end < m_byName->Length && m_items[m_byName[end]]->Name->StartsWith(prefix, StringComparison::OrdinalIgnoreCase))
+        end++;
+
+    array<int>^ r = gcnew array<int>(end - lo);
+    Array::Copy(m_byName, lo, r, 0, r->Length);
+    Array::Sort(r);
+    return r;
+}
+
+array<int>^ CoordinateReferenceSystemCatalog::TypeCandidates(array<ProjType>^ types)
+{
+    List<int>^ all = gcnew List<int>();
+
+    for each (auto kv in m_byType)
+    {
+        if (Array::IndexOf(types, kv.Key) >= 0)
+            all->AddRange(kv.Value);
+    }
+
+    array<int>^ r = all->ToArray();
+    Array::Sort(r);
+    return r;
+}
+
+array<int>^ CoordinateReferenceSystemCatalog::AreaCandidates(double west, double south, double east, double north)
+{
+    std::vector<int> items;
+    double range[4];
+    int n = lon_ranges(west, east, range);
+
+    for (int r = 0; r < n; r++)
+        m_rtree->query(range[2 * r], south, range[2 * r + 1], north, items);
+
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+
+    array<int>^ result = gcnew array<int>((int)items.size());
+    if (result->Length)
+    {
+        pin_ptr<int> pResult = &result[0];
+        std::copy(items.begin(), items.end(), (int*)pResult);
+    }
+    return result;
+}
+
+// Expands the abstract types, like the database query does
+static array<ProjType>^ ExpandTypes(List<ProjType>^ types)
+{
+    List<ProjType>^ r = gcnew List<ProjType>(types);
+
+    if (types->Contains(ProjType::GeodeticCrs))
+    {
+        r->Add(ProjType::GeocentricCrs);
+        r->Add(ProjType::Geographic2DCrs);
+        r->Add(ProjType::Geographic3DCrs);
+    }
+    if (types->Contains(ProjType::GeographicCrs))
+    {
+        r->Add(ProjType::Geographic2DCrs);
+        r->Add(ProjType::Geographic3DCrs);
+    }
+    return r->ToArray();
+}
+
+array<int>^ CoordinateReferenceSystemCatalog::Filter(CoordinateReferenceSystemFilter^ filter)
+{
+    return Filter(filter, filter->CoordinateArea, filter->CompletelyContainsArea);
+}
+
+private ref class CatalogAreaComparer : System::Collections::Generic::IComparer<int>
+{
+    initonly array<double>^ m_area;
+
+public:
+    CatalogAreaComparer(array<double>^ area)
+    {
+        m_area = area;
+    }
+
+    virtual int Compare(int x, int y)
+    {
+        int n = m_area[x].CompareTo(m_area[y]);
+
+        return n ? n : (x - y);
+    }
+};
+
+array<int>^ CoordinateReferenceSystemCatalog::FindCovering(CoordinateArea^ area, CoordinateReferenceSystemFilter^ filter)
+{
+    array<int>^ found = Filter(filter, area, true);
+
+    Array::Sort(found, gcnew CatalogAreaComparer(m_area));
+    return found;
+}
+
+array<int>^ CoordinateReferenceSystemCatalog::Filter(CoordinateReferenceSystemFilter^ filter, CoordinateArea^ area, bool contains)
+{
+    array<ProjType>^ types = filter->Types->Count ? ExpandTypes(filter->Types) : nullptr;
+    String^ prefix = String::IsNullOrEmpty(filter->NamePrefix) ? nullptr : filter->NamePrefix;
+
+    // Start with the smallest indexed set of candidates and check the other conditions on those
+    array<int>^ candidates = nullptr;
+    array<int>^ c;
+
+    if (filter->Authority)
+    {
+        if (!m_byAuthority->TryGetValue(filter->Authority, c))
+            return EMPTY_ARRAY(int);
+        candidates = c;
+    }
+    if (filter->CelestialBodyName)
+    {
+        if (!m_byBody->TryGetValue(filter->CelestialBodyName, c))
+            return EMPTY_ARRAY(int);
+        if (!candidates || c->Length < candidates->Length)
+            candidates = c;
+    }
+    if (types)
+    {
+        c = TypeCandidates(types);
+        if (!candidates || c->Length < candidates->Length)
+            candidates = c;
+    }
+    if (prefix)
+    {
+        c = NameRange(prefix);
+        if (!candidates || c->Length < candidates->Length)
+            candidates = c;
+    }
+    if (area)
+    {
+        c = AreaCandidates(area->WestLongitude, area->SouthLatitude, area->EastLongitude, area->NorthLatitude);
+        if (!candidates || c->Length < candidates->Length)
+            candidates = c;
+    }
+
+    int n = candidates ? candidates->Length : m_items->Length;
+
+    if (!n)
+        return EMPTY_ARRAY(int);
+
+    List<int>^ result = gcnew List<int>(n);
+
+    pin_ptr<double> pBox = &m_bbox[0];
+
+    for (int i = 0; i < n; i++)
+    {
+        int item = candidates ? candidates[i] : i;
+
+        if (Matches(item, filter, types, prefix, area, contains, pBox))
+            result->Add(item);
+    }
+
+    return result->ToArray();
+}
+
+bool CoordinateReferenceSystemCatalog::Matches(int item, CoordinateReferenceSystemFilter^ filter, array<ProjType>^ types, String^ prefix, CoordinateArea^ area, bool contains, const double* pBox)
+{
+    CoordinateReferenceSystemInfo^ info = m_items[item];
+
+    if (!filter->AllowDeprecated && info->IsDeprecated)
+        return false;
+    else if (filter->Authority && !String::Equals(filter->Authority, info->Authority))
+        return false;
+    else if (filter->CelestialBodyName && !String::Equals(filter->CelestialBodyName, info->CelestialBodyName))
+        return false;
+    else if (types && Array::IndexOf(types, info->Type) < 0)
+        return false;
+    else if (prefix && !info->Name->StartsWith(prefix, StringComparison::OrdinalIgnoreCase))
+        return false;
+    else if (area && !bbox_matches(pBox + 4 * item, area->WestLongitude, area->SouthLatitude, area->EastLongitude, area->NorthLatitude, contains))
+        return false;
+
+    return true;
+}
+
+// Word and trigram index over the names of the catalog items
+private ref class CatalogTextIndex sealed
+{
+    // Sorted, normalized words
+    initonly array<String^>^ m_words;
+    // Per word: (item << 2) | field, where field is 0 for the name, 1 for the area name and 2 for the projection name
+    initonly array<array<int>^>^ m_postings;
+    // Per trigram: the words containing it
+    initonly Dictionary<__int64, array<int>^>^ m_trigrams;
+
+    static __int64 Trigram(String^ s, int i)
+    {
+        return ((__int64)s[i] << 32) | ((__int64)s[i + 1] << 16) | (__int64)s[i + 2];
+    }
+
+public:
+    // Lower case, without diacritics, with everything except letters and digits as separator
+    static List<String^>^ Tokenize(String^ text)
+    {
+        List<String^>^ words = gcnew List<String^>();
+
+        if (String::IsNullOrEmpty(text))
+            return words;
+
+        String^ d = text->Normalize(System::Text::NormalizationForm::FormD);
+        System::Text::StringBuilder^ sb = gcnew System::Text::StringBuilder();
+
+        for each (wchar_t c in d)
+        {
+            if (Char::IsLetterOrDigit(c))
+                sb->Append(Char::ToLowerInvariant(c));
+            else if (System::Globalization::CharUnicodeInfo::GetUnicodeCategory(c) == System::Globalization::UnicodeCategory::NonSpacingMark)
+                continue;
+            else if (sb->Length)
+            {
+                words->Add(sb->ToString());
+                sb->Clear();
+            }
+        }
+        if (sb->Length)
+            words->Add(sb->ToString());
+
+        return words;
+    }
+
+    CatalogTextIndex(array<CoordinateReferenceSystemInfo^>^ items)
+    {
+        auto words = gcnew Dictionary<String^, List<int>^>(StringComparer::Ordinal);
+
+        for (int i = 0; i < items->Length; i++)
+        {
+            array<String^>^ fields = { items[i]->Name, items[i]->AreaName, items[i]->ProjectionName };
+
+            for (int f = 0; f < fields->Length; f++)
+            {
+                for each (String ^ w in Tokenize(fields[f]))
+                {
+                    List<int>^ lst;
+                    if (!words->TryGetValue(w, lst))
+                        words->Add(w, lst = gcnew List<int>());
+
+                    int posting = (i << 2) | f;
+                    if (!lst->Count || lst[lst->Count - 1] != posting)
+                        lst->Add(posting);
+                }
+            }
+        }
+
+        m_words = gcnew array<String^>(words->Count);
+        words->Keys->CopyTo(m_words, 0);
+        Array::Sort(m_words, StringComparer::Ordinal);
+
+        m_postings = gcnew array<array<int>^>(m_words->Length);
+        auto trigrams = gcnew Dictionary<__int64, List<int>^>();
+
+        for (int i = 0; i < m_words->Length; i++)
+        {
+            String^ w = m_words[i];
+            m_postings[i] = words[w]->ToArray();
+
+            for (int j = 0; j + 3 <= w->Length; j++)
+            {
+                List<int>^ lst;
+                __int64 t = Trigram(w, j);
+
+                if (!trigrams->TryGetValue(t, lst))
+                    trigrams->Add(t, lst = gcnew List<int>());
+
+                if (!lst->Count || lst[lst->Count - 1] != i)
+                    lst->Add(i);
+            }
+        }
+
+        m_trigrams = gcnew Dictionary<__int64, array<int>^>(trigrams->Count);
+        for each (auto kv in trigrams)
+            m_trigrams->Add(kv.Key, kv.Value->ToArray());
+    }
+
+    // Gets the item scores for all items with a word containing word: 4 for the same word, 2 for a prefix and 1 otherwise.
+    // Multiplied by 3 for matches in the name
+    Dictionary<int, int>^ Match(String^ word)
+    {
+        List<int>^ found = gcnew List<int>();
+
+        if (word->Length < 3)
+        {
+            // Too short for trigrams: Only look for prefixes
+            int lo = Array::BinarySearch(m_words, word, StringComparer::Ordinal);
+            if (lo < 0)
+                lo = ~lo;
+
+            for (int i = lo; i < m_words->Length && m_words[i]->StartsWith(word, StringComparison::Ordinal); i++)
+                found->Add(i);
+        }
+        else
+        {
+            array<int>^ smallest = nullptr;
+
+            for (int j = 0; j + 3 <= word->Length; j++)
+            {
+                array<int>^ c;
+                if (!m_trigrams->TryGetValue(Trigram(word, j), c))
+                    return gcnew Dictionary<int, int>();
+
+                if (!smallest || c->Length < smallest->Length)
+                    smallest = c;
+            }
+
+            for each (int i in smallest)
+            {
+                if (m_words[i]->Contains(word))
+                    found->Add(i);
+            }
+        }
+
+        Dictionary<int, int>^ scores = gcnew Dictionary<int, int>();
+
+        for each (int i in found)
+        {
+            String^ w = m_words[i];
+            int score = (w->Length == word->Length) ? 4 : (w->StartsWith(word, StringComparison::Ordinal) ? 2 : 1);
+
+            for each (int posting in m_postings[i])
+            {
+                int item = posting >> 2;
+                int s = ((posting & 3) == 0) ? 3 * score : score;
+                int prev;
+
+                if (!scores->TryGetValue(item, prev) || prev < s)
+                    scores[item] = s;
+            }
+        }
+        return scores;
+    }
+};
+
+private ref class CatalogScoreComparer : System::Collections::Generic::IComparer<int>
+{
+    initonly Dictionary<int, int>^ m_scores;
+    initonly array<CoordinateReferenceSystemInfo^>^ m_items;
+
+public:
+    CatalogScoreComparer(Dictionary<int, int>^ scores, array<CoordinateReferenceSystemInfo^>^ items)
+    {
+        m_scores = scores;
+        m_items = items;
+    }
+
+    virtual int Compare(int x, int y)
+    {
+        int n = m_scores[y] - m_scores[x];
+        if (n != 0)
+            return n;
+
+        // Prefer shorter names, which match relatively more of the text
+        n = m_items[x]->Name->Length - m_items[y]->Name->Length;
+
+        return n ? n : (x - y);
+    }
+};
+
+array<int>^ CoordinateReferenceSystemCatalog::Search(String^ text, int maxResults, CoordinateReferenceSystemFilter^ filter)
+{
+    CatalogTextIndex^ index = static_cast<CatalogTextIndex^>(m_textIndex);
+
+    if (!index)
+    {
+        Monitor::Enter(s_lock);
+        try
+        {
+            if (!m_textIndex)
+                m_textIndex = gcnew CatalogTextIndex(m_items);
+
+            index = static_cast<CatalogTextIndex^>(m_textIndex);
+        }
+        finally
+        {
+            Monitor::Exit(s_lock);
+        }
+    }
+
+    Dictionary<int, int>^ scores = nullptr;
+
+    // All words must match; the scores of the words are added
+    for each (String ^ word in CatalogTextIndex::Tokenize(text))
+    {
+        Dictionary<int, int>^ match = index->Match(word);
+
+        if (!scores)
+            scores = match;
+        else
+        {
+            Dictionary<int, int>^ both = gcnew Dictionary<int, int>();
+
+            for each (auto kv in scores)
+            {
+                int s;
+                if (match->TryGetValue(kv.Key, s))
+                    both->Add(kv.Key, kv.Value + s);
+            }
+            scores = both;
+        }
+
+        if (!scores->Count)
+            break;
+    }
+
+    if (!scores || !scores->Count)
+        return EMPTY_ARRAY(int);
+
+    List<int>^ found = gcnew List<int>(scores->Count);
+
+    if (filter)
+    {
+        // Only the scored candidates are checked against the filter
+        array<ProjType>^ types = filter->Types->Count ? ExpandTypes(filter->Types) : nullptr;
+        String^ prefix = String::IsNullOrEmpty(filter->NamePrefix) ? nullptr : filter->NamePrefix;
+        pin_ptr<double> pBox = &m_bbox[0];
+
+        for each (int item in scores->Keys)
+        {
+            if (Matches(item, filter, types, prefix, filter->CoordinateArea, filter->CompletelyContainsArea, pBox))
+                found->Add(item);
+        }
+    }
+    else
+        found->AddRange(scores->Keys);
+
+    found->Sort(gcnew CatalogScoreComparer(scores, m_items));
+
+    if (maxResults >= 0 && found->Count > maxResults)
+        found->RemoveRange(maxResults, found->Count - maxResults);
+
+    return found->ToArray();
+}
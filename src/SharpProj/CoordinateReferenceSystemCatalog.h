@@ -0,0 +1,88 @@
+#pragma once
+#include "CoordinateReferenceSystemInfo.h"
+
+struct crs_rtree;
+
+namespace SharpProj {
+    namespace Proj {
+        using System::Collections::Generic::Dictionary;
+
+        /// <summary>
+        /// Immutable snapshot of all coordinate reference systems in a database, with indexes for the filters
+        /// supported by <see cref="CoordinateReferenceSystemFilter"/>. Loaded once per database (version) and
+        /// shared by all contexts.
+        /// </summary>
+        private ref class CoordinateReferenceSystemCatalog sealed
+        {
+        private:
+            // All items, in the order previously produced by sorting the database results
+            initonly array<CoordinateReferenceSystemInfo^>^ m_items;
+            // west, south, east, north per item. NaN when no area is known
+            initonly array<double>^ m_bbox;
+            initonly Dictionary<String^, array<int>^>^ m_byAuthority;
+            initonly Dictionary<ProjType, array<int>^>^ m_byType;
+            initonly Dictionary<String^, array<int>^>^ m_byBody;
+            // Item indexes sorted by name
+            initonly array<int>^ m_byName;
+            // Relative size of the area of use per item, for ranking
+            initonly array<double>^ m_area;
+            crs_rtree* m_rtree;
+            // Created on first search
+            Object^ m_textIndex;
+
+            static initonly Object^ s_lock = gcnew Object();
+            static initonly Dictionary<String^, CoordinateReferenceSystemCatalog^>^ s_catalogs
+                = gcnew Dictionary<String^, CoordinateReferenceSystemCatalog^>(StringComparer::Ordinal);
+
+            CoordinateReferenceSystemCatalog(ProjContext^ ctx);
+
+            array<int>^ NameRange(String^ prefix);
+            array<int>^ TypeCandidates(array<ProjType>^ types);
+            array<int>^ AreaCandidates(double west, double south, double east, double north);
+            array<int>^ Filter(CoordinateReferenceSystemFilter^ filter, CoordinateArea^ area, bool contains);
+            bool Matches(int item, CoordinateReferenceSystemFilter^ filter, array<ProjType>^ types, String^ prefix, CoordinateArea^ area, bool contains, const double* pBox);
+
+            ~CoordinateReferenceSystemCatalog()
+            {
+                this->!CoordinateReferenceSystemCatalog();
+            }
+            !CoordinateReferenceSystemCatalog();
+
+        public:
+            static CoordinateReferenceSystemCatalog^ Get(ProjContext^ ctx);
+
+            property int Count
+            {
+                int get()
+                {
+                    return m_items->Length;
+                }
+            }
+
+            property CoordinateReferenceSystemInfo^ default[int]
+            {
+                CoordinateReferenceSystemInfo^ get(int index)
+                {
+                    return m_items[index];
+                }
+            }
+
+            /// <summary>
+            /// Gets the (ascending) indexes of all items matching the filter
+            /// </summary>
+            array<int>^ Filter(CoordinateReferenceSystemFilter^ filter);
+
+            /// <summary>
+            /// Gets the indexes of all items matching the filter, of which the area of use contains the area. Ordered
+            /// by the size of the area of use, smallest first
+            /// </summary>
+            array<int>^ FindCovering(CoordinateArea^ area, CoordinateReferenceSystemFilter^ filter);
+
+            /// <summary>
+            /// Gets the indexes of at most maxResults items matching all words in text by name, area name or projection
+            /// name. Ordered by relevance
+            /// </summary>
+            array<int>^ Search(String^ text, int maxResults, CoordinateReferenceSystemFilter^ filter);
+        };
+    }
+}
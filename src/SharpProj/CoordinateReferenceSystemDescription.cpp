@@ -0,0 +1,200 @@
+#include "pch.h"
+#include <vector>
+#include <limits>
+
+#include "ProjContext.h"
+#include "CoordinateReferenceSystem.h"
+#include "CoordinateReferenceSystemDescription.h"
+
+using namespace SharpProj;
+using namespace SharpProj::Proj;
+
+#pragma managed(push, off)
+namespace {
+    struct axis_description
+    {
+        std::string name;
+        std::string abbrev;
+        std::string direction;
+        std::string unit_name;
+        double unit_factor;
+    };
+
+    struct crs_description
+    {
+        std::string name;
+        bool has_id;
+        std::string auth;
+        std::string code;
+        std::string geod_name;
+        std::string datum_name;
+        std::string ellps_name;
+        double semi_major;
+        double semi_minor;
+        double inv_flattening;
+        std::string pm_name;
+        double pm_longitude;
+        int cs_type;
+        std::vector<axis_description> axis;
+        bool has_area;
+        double area[4];
+        std::string area_name;
+    };
+
+    static inline void copy_str(std::string& to, const char* from)
+    {
+        if (from)
+            to = from;
+    }
+
+    static void describe_axis(PJ_CONTEXT* ctx, const PJ* crs, crs_description& d, bool setType)
+    {
+        PJ* cs = proj_crs_get_coordinate_system(ctx, crs);
+
+        if (!cs)
+            return;
+
+        if (setType)
+            d.cs_type = (int)proj_cs_get_type(ctx, cs);
+
+        int n = proj_cs_get_axis_count(ctx, cs);
+        for (int i = 0; i < n; i++)
+        {
+            const char* name = nullptr, * abbrev = nullptr, * direction = nullptr, * unit_name = nullptr;
+            axis_description a{};
+
+            if (proj_cs_get_axis_info(ctx, cs, i, &name, &abbrev, &direction, &a.unit_factor, &unit_name, nullptr, nullptr))
+            {
+                copy_str(a.name, name);
+                copy_str(a.abbrev, abbrev);
+                copy_str(a.direction, direction);
+                copy_str(a.unit_name, unit_name);
+                d.axis.push_back(std::move(a));
+            }
+        }
+        proj_destroy(cs);
+    }
+
+    // Collects everything in one pass, creating and destroying the intermediate PROJ objects directly
+    static void describe_crs(PJ_CONTEXT* ctx, const PJ* crs, crs_description& d)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        d.semi_major = d.semi_minor = d.inv_flattening = d.pm_longitude = nan;
+        d.cs_type = PJ_CS_TYPE_UNKNOWN;
+
+        copy_str(d.name, proj_get_name(crs));
+
+        const char* auth = proj_get_id_auth_name(crs, 0);
+        const char* code = proj_get_id_code(crs, 0);
+        if ((d.has_id = (auth && code)))
+        {
+            d.auth = auth;
+            d.code = code;
+        }
+
+        const char* area_name = nullptr;
+        d.has_area = proj_get_area_of_use(ctx, crs, &d.area[0], &d.area[1], &d.area[2], &d.area[3], &area_name)
+            && d.area[0] > -1000.0;
+        copy_str(d.area_name, area_name);
+
+        if (PJ* geod = proj_crs_get_geodetic_crs(ctx, crs))
+        {
+            copy_str(d.geod_name, proj_get_name(geod));
+            proj_destroy(geod);
+        }
+
+        PJ* datum = proj_crs_get_datum(ctx, crs);
+        if (!datum)
+            datum = proj_crs_get_datum_ensemble(ctx, crs);
+        if (datum)
+        {
+            copy_str(d.datum_name, proj_get_name(datum));
+            proj_destroy(datum);
+        }
+
+        if (PJ* ellps = proj_get_ellipsoid(ctx, crs))
+        {
+            copy_str(d.ellps_name, proj_get_name(ellps));
+            proj_ellipsoid_get_parameters(ctx, ellps, &d.semi_major, &d.semi_minor, nullptr, &d.inv_flattening);
+            proj_destroy(ellps);
+        }
+
+        if (PJ* pm = proj_get_prime_meridian(ctx, crs))
+        {
+            copy_str(d.pm_name, proj_get_name(pm));
+            proj_prime_meridian_get_parameters(ctx, pm, &d.pm_longitude, nullptr, nullptr);
+            proj_destroy(pm);
+        }
+
+        if (proj_get_type(crs) == PJ_TYPE_COMPOUND_CRS)
+        {
+            // Concatenate the axis of the horizontal and vertical parts
+            for (int i = 0; ; i++)
+            {
+                PJ* sub = proj_crs_get_sub_crs(ctx, crs, i);
+                if (!sub)
+                    break;
+
+                describe_axis(ctx, sub, d, false);
+                proj_destroy(sub);
+            }
+        }
+        else
+            describe_axis(ctx, crs, d, true);
+    }
+}
+#pragma managed(pop)
+
+static String^ to_string(const std::string& v)
+{
+    return v.empty() ? nullptr : Utf8_PtrToString(v.c_str(), (int)v.length());
+}
+
+CoordinateReferenceSystemDescription^ CoordinateReferenceSystem::Describe()
+{
+    if (!m_description)
+    {
+        crs_description d{};
+        describe_crs(Context, this, d);
+        Context->ClearError(this);
+
+        CoordinateReferenceSystemDescription^ r = gcnew CoordinateReferenceSystemDescription();
+        r->m_name = to_string(d.name);
+        r->m_type = Type;
+        r->m_deprecated = IsDeprecated;
+        if (d.has_id)
+            r->m_identifier = gcnew Identifier(to_string(d.auth), to_string(d.code));
+        r->m_geodeticCrsName = to_string(d.geod_name);
+        r->m_datumName = to_string(d.datum_name);
+        r->m_ellipsoidName = to_string(d.ellps_name);
+        r->m_semiMajorMetre = d.semi_major;
+        r->m_semiMinorMetre = d.semi_minor;
+        r->m_inverseFlattening = d.inv_flattening;
+        r->m_primeMeridianName = to_string(d.pm_name);
+        r->m_primeMeridianLongitude = d.pm_longitude;
+        r->m_csType = (Proj::CoordinateSystemType)d.cs_type;
+
+        r->m_axis = gcnew array<AxisDescription>((int)d.axis.size());
+        for (int i = 0; i < r->m_axis->Length; i++)
+        {
+            const axis_description& a = d.axis[i];
+            r->m_axis[i] = AxisDescription(to_string(a.name), to_string(a.abbrev), to_string(a.direction), to_string(a.unit_name), a.unit_factor);
+        }
+
+        if (d.has_area)
+        {
+            r->m_usageArea = gcnew ProjArea(d.area[0], d.area[1], d.area[2], d.area[3]);
+            r->m_usageAreaName = to_string(d.area_name);
+        }
+        else if (m_from)
+        {
+            // Axis normalized variants lose the usage area. Use the original
+            auto from = m_from->Describe();
+            r->m_usageArea = from->m_usageArea;
+            r->m_usageAreaName = from->m_usageAreaName;
+        }
+
+        m_description = r;
+    }
+    return m_description;
+}
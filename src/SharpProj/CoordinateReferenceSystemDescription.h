@@ -0,0 +1,107 @@
+#pragma once
+#include "CoordinateSystem.h"
+#include "ProjIdentifier.h"
+#include "ProjArea.h"
+
+namespace SharpProj {
+    namespace Proj {
+
+        /// <summary>
+        /// Axis information in a <see cref="CoordinateReferenceSystemDescription"/>
+        /// </summary>
+        [DebuggerDisplay("{Name,nq} ({Direction,nq})")]
+        public value class AxisDescription
+        {
+        private:
+            initonly String^ m_name;
+            initonly String^ m_abbrev;
+            initonly String^ m_direction;
+            initonly String^ m_unitName;
+            initonly double m_unitConversionFactor;
+
+        internal:
+            AxisDescription(String^ name, String^ abbreviation, String^ direction, String^ unitName, double unitConversionFactor)
+            {
+                m_name = name;
+                m_abbrev = abbreviation;
+                m_direction = direction;
+                m_unitName = unitName;
+                m_unitConversionFactor = unitConversionFactor;
+            }
+
+        public:
+            property String^ Name { String^ get() { return m_name; } }
+            property String^ Abbreviation { String^ get() { return m_abbrev; } }
+            property String^ Direction { String^ get() { return m_direction; } }
+            property String^ UnitName { String^ get() { return m_unitName; } }
+            property double UnitConversionFactor { double get() { return m_unitConversionFactor; } }
+        };
+
+        /// <summary>
+        /// Immutable summary of the commonly used metadata of a <see cref="CoordinateReferenceSystem"/>, obtained in a single pass
+        /// via <see cref="CoordinateReferenceSystem::Describe"/>, without creating the <see cref="Datum"/>, <see cref="Ellipsoid"/>,
+        /// <see cref="CoordinateSystem"/>, ... objects.
+        /// </summary>
+        [DebuggerDisplay("{Name,nq}")]
+        public ref class CoordinateReferenceSystemDescription sealed
+        {
+        internal:
+            String^ m_name;
+            ProjType m_type;
+            bool m_deprecated;
+            Identifier^ m_identifier;
+            String^ m_geodeticCrsName;
+            String^ m_datumName;
+            String^ m_ellipsoidName;
+            double m_semiMajorMetre;
+            double m_semiMinorMetre;
+            double m_inverseFlattening;
+            String^ m_primeMeridianName;
+            double m_primeMeridianLongitude;
+            Proj::CoordinateSystemType m_csType;
+            array<AxisDescription>^ m_axis;
+            ProjArea^ m_usageArea;
+            String^ m_usageAreaName;
+
+            CoordinateReferenceSystemDescription()
+            {
+            }
+
+        public:
+            property String^ Name { String^ get() { return m_name; } }
+            property ProjType Type { ProjType get() { return m_type; } }
+            property bool IsDeprecated { bool get() { return m_deprecated; } }
+            /// <summary>The first identifier of the coordinate reference system, or null if it has none</summary>
+            property Proj::Identifier^ Identifier { Proj::Identifier^ get() { return m_identifier; } }
+
+            property String^ GeodeticCRSName { String^ get() { return m_geodeticCrsName; } }
+            /// <summary>Name of the datum or datum ensemble</summary>
+            property String^ DatumName { String^ get() { return m_datumName; } }
+            property String^ EllipsoidName { String^ get() { return m_ellipsoidName; } }
+            /// <summary>NaN if there is no ellipsoid</summary>
+            property double SemiMajorMetre { double get() { return m_semiMajorMetre; } }
+            /// <summary>NaN if there is no ellipsoid</summary>
+            property double SemiMinorMetre { double get() { return m_semiMinorMetre; } }
+            /// <summary>NaN if there is no ellipsoid</summary>
+            property double InverseFlattening { double get() { return m_inverseFlattening; } }
+            property String^ PrimeMeridianName { String^ get() { return m_primeMeridianName; } }
+            /// <summary>Longitude of the prime meridian in its own unit. NaN if there is no prime meridian</summary>
+            property double PrimeMeridianLongitude { double get() { return m_primeMeridianLongitude; } }
+
+            property Proj::CoordinateSystemType CoordinateSystemType { Proj::CoordinateSystemType get() { return m_csType; } }
+            /// <summary>Number of axes, or -1 if there is no coordinate system. For compound CRSs the axes of the components
+            /// are counted, like <see cref="CoordinateReferenceSystem::AxisCount"/> does</summary>
+            property int AxisCount { int get() { return m_axis->Length ? m_axis->Length : -1; } }
+            property ReadOnlyCollection<AxisDescription>^ Axis { ReadOnlyCollection<AxisDescription>^ get() { return Array::AsReadOnly(m_axis); } }
+
+            /// <summary>Area of use, or null if unknown</summary>
+            property ProjArea^ UsageArea { ProjArea^ get() { return m_usageArea; } }
+            property String^ UsageAreaName { String^ get() { return m_usageAreaName; } }
+
+            virtual String^ ToString() override
+            {
+                return Name;
+            }
+        };
+    }
+}
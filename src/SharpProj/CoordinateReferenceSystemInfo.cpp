@@ -2,99 +2,92 @@
 #include "ProjObject.h"
 #include "CoordinateReferenceSystem.h"
 #include "CoordinateReferenceSystemInfo.h"
+#include "CoordinateReferenceSystemCatalog.h"
+#include "CoordinateArea.h"
 
-private ref class CRSComparer : System::Collections::Generic::IComparer<CoordinateReferenceSystemInfo^>
+ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::GetCoordinateReferenceSystems(CoordinateReferenceSystemFilter^ filter)
 {
-public:
-    // Inherited via IComparer
-    virtual int Compare(SharpProj::Proj::CoordinateReferenceSystemInfo^ x, SharpProj::Proj::CoordinateReferenceSystemInfo^ y)
-    {
-        int n = StringComparer::OrdinalIgnoreCase->Compare(x->Authority, y->Authority);
-        if (n != 0)
-            return n;
-
-        int xi, yi;
-
-        if (int::TryParse(x->Code, xi) && int::TryParse(y->Code, yi))
-        {
-            n = xi - yi;
+    if (!filter)
+        throw gcnew ArgumentNullException("filter");
 
-            if (n != 0)
-                return n;
-        }
+    CoordinateReferenceSystemCatalog^ catalog = Catalog;
+    array<int>^ found = catalog->Filter(filter);
+    array<CoordinateReferenceSystemInfo^>^ result = gcnew array<CoordinateReferenceSystemInfo^>(found->Length);
 
-        return StringComparer::OrdinalIgnoreCase->Compare(x->Name, y->Name);
-    }
+    for (int i = 0; i < found->Length; i++)
+        result[i] = GetCatalogItem(found[i]);
 
-    static initonly CRSComparer^ Instance = gcnew CRSComparer();
-};
+    return Array::AsReadOnly(result);
+}
 
-ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::GetCoordinateReferenceSystems(CoordinateReferenceSystemFilter^ filter)
+ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::FindCoordinateReferenceSystems(double longitude, double latitude, [Optional] CoordinateReferenceSystemFilter^ filter)
 {
-    if (!filter)
-        throw gcnew ArgumentNullException("filter");
-
-    std::string auth_name;
-    std::string body_name;
-    if (filter->Authority)
-        auth_name = ::utf8_string(filter->Authority);
-    PROJ_CRS_LIST_PARAMETERS* params = proj_get_crs_list_parameters_create();
+    return FindCoordinateReferenceSystems(gcnew CoordinateArea(longitude, latitude, longitude, latitude), filter);
+}
 
-    try
-    {
-        auto types = filter->Types->ToArray();
-        pin_ptr<ProjType> pTypes;
+ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::FindCoordinateReferenceSystems(CoordinateArea^ area, [Optional] CoordinateReferenceSystemFilter^ filter)
+{
+    if (!area)
+        throw gcnew ArgumentNullException("area");
+    else if (!filter)
+        filter = gcnew CoordinateReferenceSystemFilter();
 
-        if (types->Length)
-        {
-            pTypes = &types[0];
-            params->typesCount = types->Length;
-            params->types = reinterpret_cast<PJ_TYPE*>(pTypes);
-        }
+    CoordinateReferenceSystemCatalog^ catalog = Catalog;
+    array<int>^ found = catalog->FindCovering(area, filter);
+    array<CoordinateReferenceSystemInfo^>^ result = gcnew array<CoordinateReferenceSystemInfo^>(found->Length);
 
-        params->allow_deprecated = filter->AllowDeprecated;
+    for (int i = 0; i < found->Length; i++)
+        result[i] = GetCatalogItem(found[i]);
 
-        if (filter->CoordinateArea)
-        {
-            params->bbox_valid = true;
+    return Array::AsReadOnly(result);
+}
 
-            params->west_lon_degree = filter->CoordinateArea->WestLongitude;
-            params->south_lat_degree = filter->CoordinateArea->SouthLatitude;
-            params->east_lon_degree = filter->CoordinateArea->EastLongitude;
-            params->north_lat_degree = filter->CoordinateArea->NorthLatitude;
+ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::SearchCoordinateReferenceSystems(String^ text)
+{
+    return SearchCoordinateReferenceSystems(text, -1, nullptr);
+}
 
-            params->crs_area_of_use_contains_bbox = filter->CompletelyContainsArea;
-        }
+ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::SearchCoordinateReferenceSystems(String^ text, int maxResults, [Optional] CoordinateReferenceSystemFilter^ filter)
+{
+    if (!text)
+        throw gcnew ArgumentNullException("text");
+    else if (!filter)
+        filter = gcnew CoordinateReferenceSystemFilter();
 
-        if (filter->CelestialBodyName)
-        {
-            body_name = ::utf8_string(filter->CelestialBodyName);
-            params->celestial_body_name = body_name.c_str();
-        }
+    CoordinateReferenceSystemCatalog^ catalog = Catalog;
+    array<int>^ found = catalog->Search(text, maxResults, filter);
+    array<CoordinateReferenceSystemInfo^>^ result = gcnew array<CoordinateReferenceSystemInfo^>(found->Length);
 
-        int count;
-        array<CoordinateReferenceSystemInfo^>^ result;
+    for (int i = 0; i < found->Length; i++)
+        result[i] = GetCatalogItem(found[i]);
 
-        PROJ_CRS_INFO** infoList = proj_get_crs_info_list_from_database(this, auth_name.length() ? auth_name.c_str() : nullptr, params, &count);
-        try
-        {
-            result = gcnew array<CoordinateReferenceSystemInfo^>(count);
+    return Array::AsReadOnly(result);
+}
 
-            for (int i = 0; i < count; i++)
-                result[i] = gcnew CoordinateReferenceSystemInfo(infoList[i], this);
-        }
-        finally
-        {
-            proj_crs_info_list_destroy(infoList);
-        }
+CoordinateReferenceSystemCatalog^ ProjContext::Catalog::get()
+{
+    // PROJ may switch to another database, e.g. when proj.db is found only after an earlier failure
+    String^ db = Utf8_PtrToString(proj_context_get_database_path(this));
 
-        Array::Sort(result, CRSComparer::Instance);
-        return Array::AsReadOnly(result);
-    }
-    finally
+    if (!m_catalog || db != m_catalogDatabase)
     {
-        proj_get_crs_list_parameters_destroy(params);
+        m_catalog = CoordinateReferenceSystemCatalog::Get(this);
+        m_catalogItems = gcnew array<CoordinateReferenceSystemInfo^>(m_catalog->Count);
+        m_catalogDatabase = db;
     }
+
+    return m_catalog;
+}
+
+// The catalog is shared between contexts, so hand out infos bound to this context
+CoordinateReferenceSystemInfo^ ProjContext::GetCatalogItem(int index)
+{
+    CoordinateReferenceSystemInfo^ info = m_catalogItems[index];
+
+    if (!info)
+        m_catalogItems[index] = info = gcnew CoordinateReferenceSystemInfo(m_catalog[index], this);
+
+    return info;
 }
 
 ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ ProjContext::GetCoordinateReferenceSystems()
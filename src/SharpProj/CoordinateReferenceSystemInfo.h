@@ -65,6 +65,20 @@ namespace SharpProj {
                     _bbox = gcnew ProjArea(info->west_lon_degree, info->south_lat_degree, info->east_lon_degree, info->north_lat_degree);
             }
 
+            CoordinateReferenceSystemInfo(CoordinateReferenceSystemInfo^ from, ProjContext^ ctx)
+            {
+                _ctx = ctx;
+                _authName = from->_authName;
+                _code = from->_code;
+                _name = from->_name;
+                _type = from->_type;
+                _deprecated = from->_deprecated;
+                _areaName = from->_areaName;
+                _projectionName = from->_projectionName;
+                _celestialBodyName = from->_celestialBodyName;
+                _bbox = from->_bbox;
+            }
+
         public:
             property String^ Authority
             {
@@ -195,6 +209,11 @@ namespace SharpProj {
             /// Body on which this crs applies. Usually 'Earth'
             /// </summary>
             property String^ CelestialBodyName;
+
+            /// <summary>
+            /// Gets or sets the text the name of the <see cref="CoordinateReferenceSystem" /> must start with (case insensitive)
+            /// </summary>
+            property String^ NamePrefix;
         };
 
         [DebuggerDisplay("{Name,nq} ({Authority,nq})")]
@@ -0,0 +1,435 @@
+#include "pch.h"
+#include "ProjContext.h"
+#include "ProjException.h"
+#include "CoordinateReferenceSystem.h"
+#include "CoordinateReferenceSystemParser.h"
+#include "ProjContextPool.h"
+
+using System::Threading::Monitor;
+using System::Collections::Generic::Dictionary;
+using System::Collections::Generic::IReadOnlyList;
+using System::Collections::Generic::List;
+using System::Text::StringBuilder;
+
+CoordinateReferenceSystemParser::CoordinateReferenceSystemParser()
+{
+    m_ctx = gcnew ProjContext();
+    m_ownsCtx = true;
+    m_parsed = gcnew Dictionary<String^, Object^>(StringComparer::Ordinal);
+}
+
+CoordinateReferenceSystemParser::CoordinateReferenceSystemParser(ProjContext^ ctx)
+{
+    if (!ctx)
+        throw gcnew ArgumentNullException("ctx");
+
+    m_ctx = ctx;
+    m_parsed = gcnew Dictionary<String^, Object^>(StringComparer::Ordinal);
+}
+
+CoordinateReferenceSystemParser::~CoordinateReferenceSystemParser()
+{
+    Clear();
+
+    if (m_ownsCtx)
+        delete m_ctx;
+}
+
+int CoordinateReferenceSystemParser::Count::get()
+{
+    Monitor::Enter(m_parsed);
+    try
+    {
+        return m_parsed->Count;
+    }
+    finally
+    {
+        Monitor::Exit(m_parsed);
+    }
+}
+
+void CoordinateReferenceSystemParser::ClearParsed()
+{
+    for each (Object ^ v in m_parsed->Values)
+    {
+        CoordinateReferenceSystem^ crs = dynamic_cast<CoordinateReferenceSystem^>(v);
+
+        if (crs)
+            delete crs;
+    }
+    m_parsed->Clear();
+}
+
+void CoordinateReferenceSystemParser::Clear()
+{
+    Monitor::Enter(m_parsed);
+    try
+    {
+        ClearParsed();
+        m_hits = 0;
+        m_misses = 0;
+    }
+    finally
+    {
+        Monitor::Exit(m_parsed);
+    }
+}
+
+static inline bool is_wkt_separator(wchar_t c)
+{
+    return c == '[' || c == ']' || c == '(' || c == ')' || c == ',';
+}
+
+String^ CoordinateReferenceSystemParser::Normalize(String^ definition)
+{
+    if (!definition)
+        throw gcnew ArgumentNullException("definition");
+
+    int start = 0;
+    int end = definition->Length;
+
+    while (start < end && (definition[start] == 0xFEFF || Char::IsWhiteSpace(definition[start])))
+        start++;
+    while (end > start && Char::IsWhiteSpace(definition[end - 1]))
+        end--;
+
+    // Fast path: nothing to collapse
+    bool clean = true;
+    for (int i = start; i < end && clean; i++)
+    {
+        if (Char::IsWhiteSpace(definition[i]) && (definition[i] != ' ' || Char::IsWhiteSpace(definition[i + 1]) || is_wkt_separator(definition[i + 1]) || is_wkt_separator(definition[i - 1])))
+            clean = false;
+    }
+
+    if (clean)
+        return (start == 0 && end == definition->Length) ? definition : definition->Substring(start, end - start);
+
+    StringBuilder^ sb = gcnew StringBuilder(end - start);
+    bool inQuotes = false;
+    bool pendingSpace = false;
+
+    for (int i = start; i < end; i++)
+    {
+        wchar_t c = definition[i];
+
+        if (inQuotes)
+        {
+            sb->Append(c);
+            inQuotes = (c != '"');
+            continue;
+        }
+        else if (Char::IsWhiteSpace(c))
+        {
+            pendingSpace = true;
+            continue;
+        }
+
+        if (pendingSpace && !is_wkt_separator(c) && sb->Length && !is_wkt_separator(sb[sb->Length - 1]))
+            sb->Append(' ');
+
+        pendingSpace = false;
+        sb->Append(c);
+        inQuotes = (c == '"');
+    }
+
+    return sb->ToString();
+}
+
+CoordinateReferenceSystem^ CoordinateReferenceSystemParser::ParseNormalized(String^ definition, ProjContext^ ctx)
+{
+    if (!definition->Length)
+        throw gcnew ArgumentException("Empty definition", "definition");
+
+    // WKT gets the more specific error reporting of proj_create_from_wkt(). PROJJSON, PROJ strings and
+    // 'AUTH:CODE' style references are handled by proj_create()
+    if (definition[0] != '{' && definition->IndexOf('[') > 0)
+        return CoordinateReferenceSystem::CreateFromWellKnownText(definition, ctx);
+    else
+        return CoordinateReferenceSystem::Create(definition, ctx);
+}
+
+// Remembers why a definition failed, to throw a new exception to every caller
+private ref class ParseFailure sealed
+{
+private:
+    initonly Type^ m_type;
+    initonly String^ m_message;
+
+public:
+    ParseFailure(Exception^ ex)
+    {
+        m_type = ex->GetType();
+        m_message = ex->Message;
+    }
+
+    Exception^ CreateException()
+    {
+        try
+        {
+            return safe_cast<Exception^>(Activator::CreateInstance(m_type, gcnew array<Object^> { m_message }));
+        }
+        catch (MissingMethodException^)
+        {
+            return gcnew ProjException(m_message);
+        }
+    }
+};
+
+Object^ CoordinateReferenceSystemParser::Resolve(String^ key)
+{
+    Object^ v;
+
+    Monitor::Enter(m_parsed);
+    try
+    {
+        if (m_parsed->TryGetValue(key, v))
+        {
+            m_hits++;
+            return v;
+        }
+    }
+    finally
+    {
+        Monitor::Exit(m_parsed);
+    }
+
+    // Parse without holding the lock, in a context that is not used by other threads
+    ProjContextPool^ pool = m_ctx->BatchPool;
+    ProjContext^ pc = pool->Rent();
+    CoordinateReferenceSystem^ created = nullptr;
+    try
+    {
+        try
+        {
+            created = ParseNormalized(key, pc);
+        }
+        catch (Exception^ ex)
+        {
+            v = gcnew ParseFailure(ex);
+        }
+
+        Monitor::Enter(m_parsed);
+        try
+        {
+            Object^ other;
+
+            // Another thread may have been first
+            if (m_parsed->TryGetValue(key, other))
+            {
+                m_hits++;
+                return other;
+            }
+
+            if (created)
+                v = created->Clone(m_ctx);
+
+            m_parsed->Add(key, v);
+            m_misses++;
+            return v;
+        }
+        finally
+        {
+            Monitor::Exit(m_parsed);
+        }
+    }
+    finally
+    {
+        if (created)
+            delete created;
+        pool->Return(pc);
+    }
+}
+
+CoordinateReferenceSystem^ CoordinateReferenceSystemParser::Parse(String^ definition)
+{
+    Object^ v = Resolve(Normalize(definition));
+
+    ParseFailure^ failure = dynamic_cast<ParseFailure^>(v);
+    if (failure)
+        throw failure->CreateException();
+
+    return static_cast<CoordinateReferenceSystem^>(v);
+}
+
+CoordinateReferenceSystem^ CoordinateReferenceSystemParser::Parse(String^ definition, ProjContext^ ctx)
+{
+    if (!ctx)
+        throw gcnew ArgumentNullException("ctx");
+
+    Object^ v = Resolve(Normalize(definition));
+
+    ParseFailure^ failure = dynamic_cast<ParseFailure^>(v);
+    if (failure)
+        throw failure->CreateException();
+
+    // Cloning only reads the shared instance. Hold the lock to keep Clear() from disposing it meanwhile
+    Monitor::Enter(m_parsed);
+    try
+    {
+        return static_cast<CoordinateReferenceSystem^>(v)->Clone(ctx);
+    }
+    finally
+    {
+        Monitor::Exit(m_parsed);
+    }
+}
+
+bool CoordinateReferenceSystemParser::TryParse(String^ definition, [Out] CoordinateReferenceSystem^% crs)
+{
+    if (String::IsNullOrWhiteSpace(definition))
+    {
+        crs = nullptr;
+        return false;
+    }
+
+    try
+    {
+        crs = Parse(definition);
+        return true;
+    }
+    catch (ProjException^)
+    {
+        crs = nullptr;
+        return false;
+    }
+}
+
+private ref class ParseBatch sealed
+{
+public:
+    List<String^>^ Definitions;
+    array<CoordinateReferenceSystem^>^ Created;
+    array<Exception^>^ Errors;
+
+    ProjContext^ Run(int i, System::Threading::Tasks::ParallelLoopState^ state, ProjContext^ ctx)
+    {
+        UNUSED_ALWAYS(state);
+        try
+        {
+            Created[i] = CoordinateReferenceSystemParser::ParseNormalized(Definitions[i], ctx);
+        }
+        catch (Exception^ ex)
+        {
+            Errors[i] = ex;
+        }
+        return ctx;
+    }
+};
+
+array<CoordinateReferenceSystem^>^ CoordinateReferenceSystemParser::Parse(IReadOnlyList<String^>^ definitions, [Out] array<Exception^>^% errors)
+{
+    if (!definitions)
+        throw gcnew ArgumentNullException("definitions");
+
+    int n = definitions->Count;
+    array<String^>^ keys = gcnew array<String^>(n);
+    array<CoordinateReferenceSystem^>^ result = gcnew array<CoordinateReferenceSystem^>(n);
+    errors = gcnew array<Exception^>(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (definitions[i])
+            keys[i] = Normalize(definitions[i]);
+    }
+
+    // Collect the distinct definitions that are not parsed yet
+    ParseBatch^ batch = gcnew ParseBatch();
+    batch->Definitions = gcnew List<String^>();
+
+    Monitor::Enter(m_parsed);
+    try
+    {
+        System::Collections::Generic::HashSet<String^>^ todo = gcnew System::Collections::Generic::HashSet<String^>(StringComparer::Ordinal);
+
+        for each (String ^ key in keys)
+        {
+            if (key && !m_parsed->ContainsKey(key) && todo->Add(key))
+                batch->Definitions->Add(key);
+        }
+    }
+    finally
+    {
+        Monitor::Exit(m_parsed);
+    }
+
+    int nNew = batch->Definitions->Count;
+    int nParsed = 0;
+    ProjContextPool^ pool = nNew ? gcnew ProjContextPool(m_ctx) : nullptr;
+    try
+    {
+        if (nNew)
+        {
+            batch->Created = gcnew array<CoordinateReferenceSystem^>(nNew);
+            batch->Errors = gcnew array<Exception^>(nNew);
+
+            System::Threading::Tasks::Parallel::For(0, nNew,
+                gcnew Func<ProjContext^>(pool, &ProjContextPool::Rent),
+                gcnew Func<int, System::Threading::Tasks::ParallelLoopState^, ProjContext^, ProjContext^>(batch, &ParseBatch::Run),
+                gcnew Action<ProjContext^>(pool, &ProjContextPool::Return));
+        }
+
+        Monitor::Enter(m_parsed);
+        try
+        {
+            // Publish the results in our own context, while the worker contexts still exist. Definitions another
+            // thread published meanwhile keep that result
+            for (int i = 0; i < nNew; i++)
+            {
+                if (m_parsed->ContainsKey(batch->Definitions[i]))
+                    continue;
+
+                CoordinateReferenceSystem^ created = batch->Created[i];
+
+                if (created)
+                    m_parsed->Add(batch->Definitions[i], created->Clone(m_ctx));
+                else
+                    m_parsed->Add(batch->Definitions[i], gcnew ParseFailure(batch->Errors[i]));
+                nParsed++;
+            }
+
+            int nKeys = 0;
+            for (int i = 0; i < n; i++)
+            {
+                if (!keys[i])
+                    continue;
+                nKeys++;
+
+                Object^ v = m_parsed[keys[i]];
+                ParseFailure^ failure = dynamic_cast<ParseFailure^>(v);
+
+                if (failure)
+                    errors[i] = failure->CreateException();
+                else
+                    result[i] = static_cast<CoordinateReferenceSystem^>(v);
+            }
+
+            m_misses += nParsed;
+            m_hits += nKeys - nParsed;
+        }
+        finally
+        {
+            Monitor::Exit(m_parsed);
+        }
+    }
+    finally
+    {
+        if (batch->Created)
+        {
+            for each (CoordinateReferenceSystem ^ c in batch->Created)
+            {
+                if (c)
+                    delete c;
+            }
+        }
+        if (pool)
+            delete pool;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if (!keys[i])
+            errors[i] = gcnew ArgumentNullException("definitions");
+    }
+
+    return result;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+namespace SharpProj {
+    ref class CoordinateReferenceSystem;
+
+    /// <summary>
+    /// Parses WKT, PROJJSON and PROJ string definitions of coordinate reference systems, reusing the result for
+    /// definitions that were parsed before. Definitions are compared after normalizing their whitespace.
+    /// </summary>
+    /// <remarks>The coordinate reference systems returned by <see cref="Parse(String^)"/> are shared, live in <see cref="Context"/>
+    /// and are owned by the parser; they are disposed together with the parser and should not be disposed by the caller.
+    /// Like all objects in a context they may only be used by one thread at a time. Other threads should use
+    /// <see cref="Parse(String^, ProjContext^)"/> with a context of their own.</remarks>
+    public ref class CoordinateReferenceSystemParser sealed
+    {
+    private:
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        initonly ProjContext^ m_ctx;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        initonly bool m_ownsCtx;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        initonly System::Collections::Generic::Dictionary<String^, Object^>^ m_parsed; // CRS in m_ctx or why parsing failed
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        __int64 m_hits;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        __int64 m_misses;
+
+        void ClearParsed();
+        Object^ Resolve(String^ key);
+
+    internal:
+        static CoordinateReferenceSystem^ ParseNormalized(String^ definition, ProjContext^ ctx);
+
+    public:
+        /// <summary>
+        /// Creates a parser with its own <see cref="ProjContext"/>
+        /// </summary>
+        CoordinateReferenceSystemParser();
+        /// <summary>
+        /// Creates a parser that creates the coordinate reference systems in <paramref name="ctx"/>
+        /// </summary>
+        CoordinateReferenceSystemParser(ProjContext^ ctx);
+
+    private:
+        ~CoordinateReferenceSystemParser();
+
+    public:
+        /// <summary>
+        /// Gets the context in which the coordinate reference systems are created
+        /// </summary>
+        property ProjContext^ Context
+        {
+            ProjContext^ get()
+            {
+                return m_ctx;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of distinct definitions parsed
+        /// </summary>
+        property int Count
+        {
+            int get();
+        }
+
+        /// <summary>
+        /// Gets the number of definitions that were answered from earlier results
+        /// </summary>
+        property __int64 Hits
+        {
+            __int64 get()
+            {
+                return System::Threading::Interlocked::Read(m_hits);
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of definitions that had to be parsed
+        /// </summary>
+        property __int64 Misses
+        {
+            __int64 get()
+            {
+                return System::Threading::Interlocked::Read(m_misses);
+            }
+        }
+
+        /// <summary>
+        /// Parses a single definition. Throws an exception of the same type and with the same message as the first attempt
+        /// for definitions that failed before
+        /// </summary>
+        CoordinateReferenceSystem^ Parse(String^ definition);
+
+        /// <summary>
+        /// Parses a single definition like <see cref="Parse(String^)"/>, but returns a new coordinate reference system in
+        /// <paramref name="ctx"/> that is owned by the caller
+        /// </summary>
+        CoordinateReferenceSystem^ Parse(String^ definition, ProjContext^ ctx);
+
+        /// <summary>
+        /// Parses a single definition. Returns false when the definition doesn't describe a coordinate reference system
+        /// </summary>
+        bool TryParse(String^ definition, [Out] CoordinateReferenceSystem^% crs);
+
+        /// <summary>
+        /// Parses all definitions. Each distinct new definition is parsed once; the parsing runs in parallel on clones
+        /// of <see cref="Context"/>.
+        /// </summary>
+        /// <param name="definitions">Definitions to parse</param>
+        /// <param name="errors">Receives per definition the exception that occurred while parsing it, or null on success</param>
+        /// <returns>Per definition the coordinate reference system, or null on failure</returns>
+        array<CoordinateReferenceSystem^>^ Parse(System::Collections::Generic::IReadOnlyList<String^>^ definitions, [Out] array<Exception^>^% errors);
+
+        /// <summary>
+        /// Disposes all parsed coordinate reference systems and forgets all definitions
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// Returns <paramref name="definition"/> without byte order mark, with leading and trailing whitespace removed
+        /// and whitespace outside quoted strings collapsed (or removed around WKT separators)
+        /// </summary>
+        static String^ Normalize(String^ definition);
+    };
+}
@@ -1,4 +1,7 @@
 #include "pch.h"
+#include <cmath>
+#include <vector>
+#include <algorithm>
 #include <geodesic.h>
 
 #include "ProjContext.h"
@@ -10,6 +13,8 @@
 #include "ProjException.h"
 #include "Ellipsoid.h"
 #include "GridUsage.h"
+#include "ProjContextPool.h"
+#include "BatchKernels.h"
 
 using namespace System::Linq;
 
@@ -29,6 +34,7 @@ CoordinateTransform::~CoordinateTransform()
         delete m_pgeod;
         m_pgeod = nullptr;
     }
+    ReleaseFastPath();
 }
 
 ProjObject^ SharpProj::CoordinateTransform::DoClone(ProjContext^ ctx)
@@ -225,6 +231,473 @@ Proj::CoordinateTransformFactors^ CoordinateTransform::Factors(PPoint coordinate
     return gcnew Proj::CoordinateTransformFactors(&f);
 }
 
+#pragma managed(push, off)
+namespace {
+    // The points of a batch: either explicit coordinates, or a row-major grid when xs is null
+    struct factor_points
+    {
+        const double* xs;
+        const double* ys;
+        double x0, y0, dx, dy;
+        int columns;
+
+        void get(int i, double& x, double& y) const
+        {
+            if (xs)
+            {
+                x = xs[i];
+                y = ys[i];
+            }
+            else
+            {
+                x = x0 + (i % columns) * dx;
+                y = y0 + (i / columns) * dy;
+            }
+        }
+    };
+
+    const int FACTOR_COMPONENTS = 12;
+
+    // Calculates the factors of points [first, first+count) and stores the components that have an output
+    void factors_range(PJ* pj, const factor_points& points, int first, int count, double* const* out)
+    {
+        for (int i = first; i < first + count; i++)
+        {
+            PJ_COORD coord;
+            points.get(i, coord.v[0], coord.v[1]);
+            coord.v[2] = 0;
+            coord.v[3] = HUGE_VAL;
+
+            proj_errno_reset(pj);
+            PJ_FACTORS f = proj_factors(pj, coord);
+
+            double v[FACTOR_COMPONENTS] = {
+                f.meridional_scale, f.parallel_scale, f.areal_scale, f.angular_distortion,
+                f.meridian_parallel_angle, f.meridian_convergence, f.tissot_semimajor, f.tissot_semiminor,
+                f.dx_dlam, f.dx_dphi, f.dy_dlam, f.dy_dphi };
+
+            bool failed = proj_errno(pj) != 0;
+
+            for (int k = 0; k < FACTOR_COMPONENTS; k++)
+            {
+                if (out[k])
+                    out[k][i] = failed ? std::nan("") : v[k];
+            }
+        }
+        proj_errno_reset(pj);
+    }
+}
+#pragma managed(pop)
+
+private ref class ClonedPJWorker sealed
+{
+public:
+    ProjContext^ Ctx;
+    PJ* Pj;
+};
+
+// Processes count items in chunks over a parallel loop, where every worker uses its own context and copy of the PJ.
+// A single chunk is processed with the original PJ on the calling thread.
+private ref class ClonedPJBatch abstract
+{
+private:
+    ProjContextPool^ m_pool;
+    PJ* m_source;
+    int m_count;
+    int m_chunkSize;
+
+    ClonedPJWorker^ Init()
+    {
+        ClonedPJWorker^ w = gcnew ClonedPJWorker();
+        w->Ctx = m_pool->Rent();
+        w->Pj = proj_clone(w->Ctx, m_source);
+
+        if (!w->Pj)
+            throw w->Ctx->ConstructException();
+
+        return w;
+    }
+
+    ClonedPJWorker^ Run(int chunk, System::Threading::Tasks::ParallelLoopState^ state, ClonedPJWorker^ w)
+    {
+        UNUSED_ALWAYS(state);
+        int first = chunk * m_chunkSize;
+
+        Process(w->Pj, first, Math::Min(m_chunkSize, m_count - first));
+        return w;
+    }
+
+    void Done(ClonedPJWorker^ w)
+    {
+        proj_destroy(w->Pj);
+        w->Pj = nullptr;
+        m_pool->Return(w->Ctx);
+    }
+
+protected:
+    virtual void Process(PJ* pj, int first, int count) abstract;
+
+public:
+    void Execute(CoordinateTransform^ source, int count, int chunkSize)
+    {
+        int chunks = (count + chunkSize - 1) / chunkSize;
+
+        if (chunks <= 1)
+        {
+            // Not worth copying the transform
+            if (count > 0)
+                Process(source, 0, count);
+            return;
+        }
+
+        m_source = source;
+        m_count = count;
+        m_chunkSize = chunkSize;
+        m_pool = source->Context->BatchPool;
+        try
+        {
+            System::Threading::Tasks::Parallel::For(0, chunks,
+                gcnew Func<ClonedPJWorker^>(this, &ClonedPJBatch::Init),
+                gcnew Func<int, System::Threading::Tasks::ParallelLoopState^, ClonedPJWorker^, ClonedPJWorker^>(this, &ClonedPJBatch::Run),
+                gcnew Action<ClonedPJWorker^>(this, &ClonedPJBatch::Done));
+        }
+        catch (System::AggregateException^ ex)
+        {
+            // Report errors like the rest of the api
+            for each (Exception ^ e in ex->Flatten()->InnerExceptions)
+            {
+                if (dynamic_cast<ProjException^>(e))
+                    throw e;
+            }
+            throw;
+        }
+        finally
+        {
+            m_pool = nullptr;
+        }
+    }
+};
+
+private ref class FactorsBatch sealed : ClonedPJBatch
+{
+public:
+    const factor_points* Points;
+    double* const* Out;
+
+protected:
+    virtual void Process(PJ* pj, int first, int count) override
+    {
+        factors_range(pj, *Points, first, count, Out);
+    }
+};
+
+void CoordinateTransform::Factors(array<double>^ xValues, array<double>^ yValues, Proj::CoordinateTransformFactorArrays^ factors)
+{
+    if (!xValues)
+        throw gcnew ArgumentNullException("xValues");
+    else if (!yValues)
+        throw gcnew ArgumentNullException("yValues");
+    else if (xValues->Length != yValues->Length)
+        throw gcnew ArgumentException("Invalid length of yValues array", "yValues");
+
+    int count = xValues->Length;
+
+    if (!count)
+        return DoFactors(nullptr, nullptr, 0, 0, 0, 0, 1, 0, factors);
+
+    pin_ptr<double> pX = &xValues[0];
+    pin_ptr<double> pY = &yValues[0];
+
+    DoFactors(pX, pY, 0, 0, 0, 0, 1, count, factors);
+}
+
+void CoordinateTransform::Factors(double minX, double minY, double stepX, double stepY, int columns, int rows, Proj::CoordinateTransformFactorArrays^ factors)
+{
+    if (columns < 0)
+        throw gcnew ArgumentOutOfRangeException("columns");
+    else if (rows < 0)
+        throw gcnew ArgumentOutOfRangeException("rows");
+    else if ((__int64)columns * rows > Int32::MaxValue)
+        throw gcnew ArgumentOutOfRangeException("rows");
+
+    DoFactors(nullptr, nullptr, minX, minY, stepX, stepY, Math::Max(columns, 1), columns * rows, factors);
+}
+
+void CoordinateTransform::DoFactors(const double* xs, const double* ys, double minX, double minY, double stepX, double stepY, int columns, int count, Proj::CoordinateTransformFactorArrays^ factors)
+{
+    if (!factors)
+        throw gcnew ArgumentNullException("factors");
+
+    array<array<double>^>^ outputs = factors->ToArray();
+
+    for each (array<double> ^ o in outputs)
+    {
+        if (o && o->Length < count)
+            throw gcnew ArgumentException("Factor array too small", "factors");
+    }
+
+    if (!count)
+        return;
+
+    factor_points points = { xs, ys, minX, minY, stepX, stepY, columns };
+    double* out[FACTOR_COMPONENTS];
+    array<System::Runtime::InteropServices::GCHandle>^ pins = gcnew array<System::Runtime::InteropServices::GCHandle>(FACTOR_COMPONENTS);
+
+    try
+    {
+        for (int k = 0; k < FACTOR_COMPONENTS; k++)
+        {
+            if (outputs[k])
+            {
+                pins[k] = System::Runtime::InteropServices::GCHandle::Alloc(outputs[k], System::Runtime::InteropServices::GCHandleType::Pinned);
+                out[k] = (double*)(void*)pins[k].AddrOfPinnedObject();
+            }
+            else
+                out[k] = nullptr;
+        }
+
+        FactorsBatch^ batch = gcnew FactorsBatch();
+        batch->Points = &points;
+        batch->Out = out;
+        batch->Execute(this, count, 4096);
+    }
+    finally
+    {
+        for (int k = 0; k < FACTOR_COMPONENTS; k++)
+        {
+            if (pins[k].IsAllocated)
+                pins[k].Free();
+        }
+    }
+}
+
+#pragma managed(push, off)
+// Implemented in FastPipeline.cpp
+void fast_trans_generic(PJ* pj, const fast_pipeline* p, PJ_DIRECTION dir, double* xs, double* ys, double* zs, int count);
+
+namespace {
+    struct roundtrip_job
+    {
+        const double* xs;
+        const double* ys;
+        const double* zs; // Optional
+        double* errors;
+        const fast_pipeline* fast; // Optional
+        PJ_DIRECTION dir;
+        int transforms;
+        const geod_geodesic* geod; // Set for angular input
+        int lonAxis;
+        bool radians;
+    };
+
+    double roundtrip_error(const roundtrip_job& job, double x0, double y0, double z0, double x1, double y1, double z1)
+    {
+        if (!std::isfinite(x1) || !std::isfinite(y1) || !std::isfinite(z1))
+            return std::nan("");
+
+        if (job.geod)
+        {
+            double lon0 = job.lonAxis ? y0 : x0;
+            double lat0 = job.lonAxis ? x0 : y0;
+            double lon1 = job.lonAxis ? y1 : x1;
+            double lat1 = job.lonAxis ? x1 : y1;
+
+            if (job.radians)
+            {
+                lon0 = proj_todeg(lon0);
+                lat0 = proj_todeg(lat0);
+                lon1 = proj_todeg(lon1);
+                lat1 = proj_todeg(lat1);
+            }
+
+            double s12;
+            geod_inverse(job.geod, lat0, lon0, lat1, lon1, &s12, nullptr, nullptr);
+
+            return std::hypot(s12, z1 - z0);
+        }
+
+        double dx = x1 - x0, dy = y1 - y0, dz = z1 - z0;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    void roundtrip_range(PJ* pj, const roundtrip_job& job, int first, int count)
+    {
+        std::vector<double> x(job.xs + first, job.xs + first + count);
+        std::vector<double> y(job.ys + first, job.ys + first + count);
+        std::vector<double> z(count, 0.0);
+
+        if (job.zs)
+            std::copy(job.zs + first, job.zs + first + count, z.begin());
+
+        for (int n = 0; n < job.transforms; n++)
+        {
+            fast_trans_generic(pj, job.fast, job.dir, x.data(), y.data(), z.data(), count);
+            fast_trans_generic(pj, job.fast, (PJ_DIRECTION)-job.dir, x.data(), y.data(), z.data(), count);
+        }
+        proj_errno_reset(pj);
+
+        for (int i = 0; i < count; i++)
+        {
+            int j = first + i;
+            job.errors[j] = roundtrip_error(job, job.xs[j], job.ys[j], job.zs ? job.zs[j] : 0.0, x[i], y[i], z[i]);
+        }
+    }
+}
+#pragma managed(pop)
+
+private ref class RoundTripBatch sealed : ClonedPJBatch
+{
+public:
+    const roundtrip_job* Job;
+
+protected:
+    virtual void Process(PJ* pj, int first, int count) override
+    {
+        roundtrip_range(pj, *Job, first, count);
+    }
+};
+
+static int lon_axis(CoordinateReferenceSystem^ crs);
+
+Proj::RoundTripStatistics^ CoordinateTransform::RoundTrip(bool forward, int transforms, array<double>^ xValues, array<double>^ yValues, array<double>^ zValues)
+{
+    if (transforms < 1)
+        throw gcnew ArgumentOutOfRangeException("transforms", "n should be >= 1");
+    else if (!xValues)
+        throw gcnew ArgumentNullException("xValues");
+    else if (!yValues)
+        throw gcnew ArgumentNullException("yValues");
+    else if (xValues->Length != yValues->Length)
+        throw gcnew ArgumentException("Invalid length of yValues array", "yValues");
+    else if (zValues && zValues->Length != xValues->Length)
+        throw gcnew ArgumentException("Invalid length of zValues array", "zValues");
+
+    int count = xValues->Length;
+    array<double>^ errors = gcnew array<double>(count);
+
+    if (!count)
+        return gcnew Proj::RoundTripStatistics(errors);
+
+    PJ_DIRECTION dir = forward ? PJ_FWD : PJ_INV;
+    roundtrip_job job = {};
+    job.dir = dir;
+    job.transforms = transforms;
+    job.radians = proj_angular_input(this, dir) != 0;
+
+    // Angular input is compared over the ellipsoid, like the single coordinate RoundTrip
+    geod_geodesic geod;
+    if (job.radians || proj_degree_input(this, dir))
+    {
+        double a = 6378137.0, invf = 298.257223563; // WGS84 when the input has no known ellipsoid
+        CoordinateReferenceSystem^ crs = forward ? SourceCRS : TargetCRS;
+
+        if (crs)
+        {
+            PJ* ell = proj_get_ellipsoid(Context, crs);
+
+            if (ell)
+            {
+                proj_ellipsoid_get_parameters(Context, ell, &a, nullptr, nullptr, &invf);
+                proj_destroy(ell);
+            }
+
+            job.lonAxis = Math::Max(lon_axis(crs), 0);
+        }
+
+        geod_init(&geod, a, invf ? 1 / invf : 0);
+        job.geod = &geod;
+    }
+
+    pin_ptr<double> pX = &xValues[0];
+    pin_ptr<double> pY = &yValues[0];
+    pin_ptr<double> pZ = nullptr;
+    if (zValues)
+        pZ = &zValues[0];
+    pin_ptr<double> pErrors = &errors[0];
+
+    job.xs = pX;
+    job.ys = pY;
+    job.zs = pZ;
+    job.errors = pErrors;
+
+    if (dynamic_cast<ChooseCoordinateTransform^>(this))
+    {
+        // The operation is chosen per coordinate in managed code, so stay on this thread
+        for (int i = 0; i < count; i++)
+        {
+            PPoint org(pX[i], pY[i], pZ ? pZ[i] : 0.0);
+            try
+            {
+                PPoint coord = org;
+
+                for (int n = 0; n < transforms; n++)
+                    coord = DoTransform(!forward, DoTransform(forward, coord));
+
+                errors[i] = roundtrip_error(job, org.X, org.Y, org.Z, coord.X, coord.Y, coord.Z);
+            }
+            catch (ProjException^)
+            {
+                errors[i] = double::NaN;
+            }
+        }
+    }
+    else
+    {
+        // Same implementation as the range Apply methods
+        if (!m_fastChecked)
+            EnsureFastPath();
+        job.fast = m_fast;
+
+        RoundTripBatch^ batch = gcnew RoundTripBatch();
+        batch->Job = &job;
+        batch->Execute(this, count, 16384);
+    }
+
+    Context->ClearError(this);
+    return gcnew Proj::RoundTripStatistics(errors);
+}
+
+Proj::RoundTripStatistics::RoundTripStatistics(array<double>^ errors)
+{
+    m_errors = errors;
+
+    int n = 0;
+    for each (double e in errors)
+    {
+        if (!double::IsNaN(e))
+            n++;
+    }
+
+    m_sorted = gcnew array<double>(n);
+    double sum = 0;
+    n = 0;
+    for each (double e in errors)
+    {
+        if (!double::IsNaN(e))
+        {
+            m_sorted[n++] = e;
+            sum += e;
+        }
+    }
+
+    Array::Sort(m_sorted);
+    m_mean = n ? sum / n : double::NaN;
+}
+
+double Proj::RoundTripStatistics::Percentile(double percentage)
+{
+    if (!(percentage >= 0 && percentage <= 100))
+        throw gcnew ArgumentOutOfRangeException("percentage");
+
+    int n = m_sorted->Length;
+
+    if (!n)
+        return double::NaN;
+
+    int rank = (int)Math::Ceiling(percentage / 100.0 * n);
+    return m_sorted[Math::Max(rank - 1, 0)];
+}
+
 PPoint CoordinateTransform::DoTransform(bool forward, PPoint% coordinate)
 {
     PJ_COORD coord;
@@ -244,6 +717,15 @@ void CoordinateTransform::DoTransform(bool forward,
     double* zVals, int zStep, int zCount,
     double* tVals, int tStep, int tCount)
 {
+    if (TryFastTransform(forward,
+        xVals, xStep, xCount,
+        yVals, yStep, yCount,
+        zVals, zStep, zCount,
+        tVals, tStep, tCount))
+    {
+        return;
+    }
+
     proj_trans_generic(this, forward ? PJ_FWD : PJ_INV,
         xVals, xStep * sizeof(double), xCount,
         yVals, yStep * sizeof(double), yCount,
@@ -379,6 +861,48 @@ double CoordinateTransform::GeoDistance(PPoint p1, PPoint p2)
     return GeoDistance(gcnew array<PPoint>{p1, p2});
 }
 
+// Transforms the points in one batch for the geodesic calculations, which take degrees
+void CoordinateTransform::GeoTransform(System::Collections::Generic::IEnumerable<PPoint>^ points, array<double>^% xs, array<double>^% ys, array<double>^% zs)
+{
+    array<PPoint>^ pts = System::Linq::Enumerable::ToArray(points);
+    int n = pts->Length;
+    array<double>^ ts = gcnew array<double>(n);
+
+    xs = gcnew array<double>(n);
+    ys = gcnew array<double>(n);
+    zs = gcnew array<double>(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        xs[i] = pts[i].X;
+        ys[i] = pts[i].Y;
+        zs[i] = pts[i].Z;
+        ts[i] = pts[i].T;
+    }
+
+    if (!n)
+        return;
+
+    pin_ptr<double> pX = &xs[0];
+    pin_ptr<double> pY = &ys[0];
+    pin_ptr<double> pZ = &zs[0];
+    pin_ptr<double> pT = &ts[0];
+
+    Apply(pX, 1, n, pY, 1, n, pZ, 1, n, pT, 1, n);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (double::IsNaN(xs[i]))
+            throw Context->ConstructException("Transform failed; Check Coordinates");
+    }
+
+    if (DistanceFlags::None != (m_distanceFlags & DistanceFlags::ApplyRad))
+    {
+        batch_scale(pX, n, RadiansToDegrees);
+        batch_scale(pY, n, RadiansToDegrees);
+    }
+}
+
 double CoordinateTransform::GeoDistance(System::Collections::Generic::IEnumerable<PPoint>^ points)
 {
     if (!points)
@@ -389,32 +913,21 @@ double CoordinateTransform::GeoDistance(System::Collections::Generic::IEnumerabl
     if (!m_pgeod)
         return double::PositiveInfinity; // Like distance methods
 
-    bool applyToRad = (DistanceFlags::None != (m_distanceFlags & DistanceFlags::ApplyRad));
-    PPoint pPrev;
-    bool first = true;
+    array<double>^ xs;
+    array<double>^ ys;
+    array<double>^ zs;
+    GeoTransform(points, xs, ys, zs);
 
     double size = 0;
 
-    for each (PPoint p in points)
+    for (int i = 1; i < xs->Length; i++)
     {
-        p = Apply(p);
-
-        if (applyToRad)
-            p = p.RadToDeg();
-
-        if (first)
-            first = false;
-        else
-        {
-            double s12, azi1, azi2;
-            /* Note: the geodesic code takes arguments in degrees */
-
-            geod_inverse(m_pgeod, pPrev.Y, pPrev.X, p.Y, p.X, &s12, &azi1, &azi2);
+        double s12, azi1, azi2;
+        /* Note: the geodesic code takes arguments in degrees */
 
-            size += s12;
-        }
+        geod_inverse(m_pgeod, ys[i - 1], xs[i - 1], ys[i], xs[i], &s12, &azi1, &azi2);
 
-        pPrev = p;
+        size += s12;
     }
 
     return size;
@@ -435,32 +948,21 @@ double CoordinateTransform::GeoDistanceZ(System::Collections::Generic::IEnumerab
     if (!m_pgeod) // Can be null
         return double::PositiveInfinity; // Like distance methods
 
-    bool applyToRad = (DistanceFlags::None != (m_distanceFlags & DistanceFlags::ApplyRad));
-    PPoint pPrev;
-    bool first = true;
+    array<double>^ xs;
+    array<double>^ ys;
+    array<double>^ zs;
+    GeoTransform(points, xs, ys, zs);
 
     double size = 0;
 
-    for each (PPoint p in points)
+    for (int i = 1; i < xs->Length; i++)
     {
-        p = Apply(p);
-
-        if (applyToRad)
-            p = p.RadToDeg();
-
-        if (first)
-            first = false;
-        else
-        {
-            double s12, azi1, azi2;
-            /* Note: the geodesic code takes arguments in degrees */
+        double s12, azi1, azi2;
+        /* Note: the geodesic code takes arguments in degrees */
 
-            geod_inverse(m_pgeod, pPrev.Y, pPrev.X, p.Y, p.X, &s12, &azi1, &azi2);
+        geod_inverse(m_pgeod, ys[i - 1], xs[i - 1], ys[i], xs[i], &s12, &azi1, &azi2);
 
-            size += hypot(s12, pPrev.Z - p.Z);
-        }
-
-        pPrev = p;
+        size += hypot(s12, zs[i - 1] - zs[i]);
     }
 
     return size;
@@ -503,20 +1005,16 @@ double CoordinateTransform::GeoArea(System::Collections::Generic::IEnumerable<PP
     if (!m_pgeod) // Can be null
         return double::PositiveInfinity; // Like distance methods
 
-    bool applyToRad = DistanceFlags::None != (m_distanceFlags & DistanceFlags::ApplyRad);
+    array<double>^ xs;
+    array<double>^ ys;
+    array<double>^ zs;
+    GeoTransform(points, xs, ys, zs);
 
     struct geod_polygon poly;
     geod_polygon_init(&poly, false);
 
-    for each (PPoint p in points)
-    {
-        p = Apply(p);
-
-        if (applyToRad)
-            p = p.RadToDeg();
-
-        geod_polygon_addpoint(m_pgeod, &poly, p.Y, p.X);
-    }
+    for (int i = 0; i < xs->Length; i++)
+        geod_polygon_addpoint(m_pgeod, &poly, ys[i], xs[i]);
 
     double poly_area;
     double perim_area;
@@ -751,3 +1249,487 @@ void CoordinateTransform::ApplyReversed(array<double, 2>^ ordinateArray)
         throw gcnew ArgumentException();
     }
 }
+
+#pragma managed(push, off)
+namespace {
+    // Writes the 4 * (densify + 1) points of the outline of box, starting at (minX, minY). Longitudes of a
+    // geographic box crossing the antimeridian continue past 180; see wrap_longitudes()
+    static void densify_box(const double* box, int densify, int lonAxis, double* xs, double* ys)
+    {
+        double x0 = box[0], y0 = box[1], x1 = box[2], y1 = box[3];
+        int n = densify + 1;
+
+        // A geographic box crossing the antimeridian has west > east
+        if (lonAxis == 0 && x0 > x1)
+            x1 += 360.0;
+        else if (lonAxis == 1 && y0 > y1)
+            y1 += 360.0;
+
+        for (int i = 0; i < n; i++)
+        {
+            double f = (double)i / n;
+            double dx = f * (x1 - x0);
+            double dy = f * (y1 - y0);
+
+            xs[i] = x0 + dx;         ys[i] = y0;
+            xs[n + i] = x1;          ys[n + i] = y0 + dy;
+            xs[2 * n + i] = x1 - dx; ys[2 * n + i] = y1;
+            xs[3 * n + i] = x0;      ys[3 * n + i] = y1 - dy;
+        }
+    }
+
+    static void wrap_longitudes(double* lon, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (lon[i] > 180.0)
+                lon[i] -= 360.0;
+        }
+    }
+
+    // Bounds of the valid points, as { minX, minY, maxX, maxY }
+    static void bounds_of(const double* xs, const double* ys, int count, double* out)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (!std::isfinite(xs[i]) || !std::isfinite(ys[i]))
+                continue;
+
+            if (xs[i] < out[0]) out[0] = xs[i];
+            if (ys[i] < out[1]) out[1] = ys[i];
+            if (xs[i] > out[2]) out[2] = xs[i];
+            if (ys[i] > out[3]) out[3] = ys[i];
+        }
+    }
+
+    struct bounds_segment
+    {
+        double s[4]; // source x0, y0, x1, y1 (unwrapped)
+        double t[4]; // target x0, y0, x1, y1
+        int depth;
+    };
+
+    // Distance of m to the line segment a-b, or HUGE_VAL if any point is invalid
+    static double chord_error(const double* a, const double* b, double mx, double my, int lonAxis)
+    {
+        if (!std::isfinite(a[0]) || !std::isfinite(a[1]) || !std::isfinite(b[0]) || !std::isfinite(b[1]) || !std::isfinite(mx) || !std::isfinite(my))
+            return HUGE_VAL;
+
+        double bx = b[0], by = b[1];
+
+        // Unwrap longitudes relative to a
+        if (lonAxis >= 0)
+        {
+            double& blon = lonAxis ? by : bx;
+            double& mlon = lonAxis ? my : mx;
+            double alon = a[lonAxis];
+
+            if (blon - alon > 180.0) blon -= 360.0; else if (alon - blon > 180.0) blon += 360.0;
+            if (mlon - alon > 180.0) mlon -= 360.0; else if (alon - mlon > 180.0) mlon += 360.0;
+        }
+
+        double dx = bx - a[0], dy = by - a[1];
+        double len2 = dx * dx + dy * dy;
+        double f = len2 > 0 ? ((mx - a[0]) * dx + (my - a[1]) * dy) / len2 : 0;
+
+        if (f < 0) f = 0; else if (f > 1) f = 1;
+
+        double ex = mx - (a[0] + f * dx);
+        double ey = my - (a[1] + f * dy);
+        return sqrt(ex * ex + ey * ey);
+    }
+
+    // Whether (x, y) is inside the source box. For a geographic source the longitude is compared by its distance east of
+    // the west edge, like ProjArea::Contains, so boxes crossing the antimeridian (west > east) match as well
+    static bool box_contains(const double* box, double x, double y, int lonAxis)
+    {
+        if (lonAxis < 0)
+            return x >= box[0] && x <= box[2] && y >= box[1] && y <= box[3];
+
+        int latAxis = 1 - lonAxis;
+        double lon = lonAxis ? y : x;
+        double lat = lonAxis ? x : y;
+        double span = box[2 + lonAxis] - box[lonAxis];
+        double d = lon - box[lonAxis];
+
+        if (span < 0)
+            span += 360;
+        if (!(d >= 0 && d < 360))
+            d -= 360 * std::floor(d / 360);
+
+        return d <= span && lat >= box[latAxis] && lat <= box[2 + latAxis];
+    }
+
+    // Reduces the transformed outline to its bounds. For a geographic target the longitudes are also
+    // evaluated in the [0, 360) range, to find the smaller box when the outline crosses the antimeridian.
+    // poles contains the source coordinates of the north and south pole (NaN when not available)
+    static bool reduce_box(const double* xs, const double* ys, int count, int lonAxis, const double* box, int srcLonAxis, const double* poles, double* out)
+    {
+        double mn[2] = { HUGE_VAL, HUGE_VAL };
+        double mx[2] = { -HUGE_VAL, -HUGE_VAL };
+        double mnShifted = HUGE_VAL, mxShifted = -HUGE_VAL;
+        int valid = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            double x = xs[i], y = ys[i];
+
+            if (!std::isfinite(x) || !std::isfinite(y))
+                continue;
+
+            valid++;
+            if (x < mn[0]) mn[0] = x;
+            if (x > mx[0]) mx[0] = x;
+            if (y < mn[1]) mn[1] = y;
+            if (y > mx[1]) mx[1] = y;
+
+            if (lonAxis >= 0)
+            {
+                double lon = lonAxis ? y : x;
+                if (lon < 0)
+                    lon += 360.0;
+
+                if (lon < mnShifted) mnShifted = lon;
+                if (lon > mxShifted) mxShifted = lon;
+            }
+        }
+
+        if (!valid)
+        {
+            out[0] = out[1] = out[2] = out[3] = std::nan("");
+            return false;
+        }
+
+        if (lonAxis >= 0)
+        {
+            int latAxis = 1 - lonAxis;
+
+            if (mx[lonAxis] - mn[lonAxis] > 180.0 && mxShifted - mnShifted < mx[lonAxis] - mn[lonAxis])
+            {
+                mn[lonAxis] = (mnShifted > 180.0) ? mnShifted - 360.0 : mnShifted;
+                mx[lonAxis] = (mxShifted > 180.0) ? mxShifted - 360.0 : mxShifted;
+            }
+
+            // A box around a pole covers all longitudes
+            for (int p = 0; p < 2; p++)
+            {
+                double px = poles[2 * p], py = poles[2 * p + 1];
+
+                if (box_contains(box, px, py, srcLonAxis))
+                {
+                    if (p == 0)
+                        mx[latAxis] = 90.0;
+                    else
+                        mn[latAxis] = -90.0;
+
+                    mn[lonAxis] = -180.0;
+                    mx[lonAxis] = 180.0;
+                }
+            }
+        }
+
+        out[0] = mn[0];
+        out[1] = mn[1];
+        out[2] = mx[0];
+        out[3] = mx[1];
+        return true;
+    }
+}
+#pragma managed(pop)
+
+// Returns the index of the longitude axis of a geographic CRS, or -1 for other CRSs
+static int lon_axis(CoordinateReferenceSystem^ crs)
+{
+    if (!crs || (crs->Type != ProjType::Geographic2DCrs && crs->Type != ProjType::Geographic3DCrs))
+        return -1;
+
+    auto axis = crs->Axis;
+    if (!axis || axis->Count < 2)
+        return -1;
+
+    String^ dir = axis[0]->Direction;
+    return (dir && (dir->StartsWith("east", StringComparison::OrdinalIgnoreCase) || dir->StartsWith("west", StringComparison::OrdinalIgnoreCase))) ? 0 : 1;
+}
+
+void CoordinateTransform::TransformBoundsPoints(bool forward, double* xs, double* ys, int count)
+{
+    // Some implementations (e.g. ChooseCoordinateTransform) write results while transforming, and then fail the whole
+    // range on a single failing point. Keep the input to retry the points one at a time
+    std::vector<double> srcX(xs, xs + count);
+    std::vector<double> srcY(ys, ys + count);
+
+    try
+    {
+        DoTransform(forward, xs, 1, count, ys, 1, count, nullptr, 0, 0, nullptr, 0, 0);
+    }
+    catch (ProjException^)
+    {
+        Context->ClearError(this);
+        for (int i = 0; i < count; i++)
+        {
+            try
+            {
+                PPoint p(srcX[i], srcY[i]);
+                p = DoTransform(forward, p);
+                xs[i] = p.X;
+                ys[i] = p.Y;
+            }
+            catch (ProjException^)
+            {
+                xs[i] = ys[i] = HUGE_VAL;
+            }
+        }
+    }
+}
+
+void CoordinateTransform::TransformBoundsPoles(bool forward, int dstLonAxis, double* poles)
+{
+    // The source coordinates of the poles, to detect boxes around a pole
+    poles[0] = poles[1] = poles[2] = poles[3] = std::nan("");
+
+    if (dstLonAxis < 0)
+        return;
+
+    double lon[2] = { 0, 0 };
+    double lat[2] = { 90, -90 };
+    double* px = dstLonAxis ? lat : lon;
+    double* py = dstLonAxis ? lon : lat;
+
+    TransformBoundsPoints(!forward, px, py, 2);
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (std::isfinite(px[i]) && std::isfinite(py[i]))
+        {
+            poles[2 * i] = px[i];
+            poles[2 * i + 1] = py[i];
+        }
+    }
+}
+
+void CoordinateTransform::DoTransformBounds(bool forward, double* bounds, int boxCount, int densifyPoints)
+{
+    if (densifyPoints <= 0)
+        densifyPoints = 21;
+
+    const int perBox = 4 * (densifyPoints + 1);
+    const int boxesPerChunk = Math::Max(1, 65536 / perBox);
+
+    int srcLonAxis = lon_axis(forward ? SourceCRS : TargetCRS);
+    int dstLonAxis = lon_axis(forward ? TargetCRS : SourceCRS);
+
+    double poles[4];
+    TransformBoundsPoles(forward, dstLonAxis, poles);
+
+    std::vector<double> xs(boxesPerChunk * perBox);
+    std::vector<double> ys(boxesPerChunk * perBox);
+
+    for (int first = 0; first < boxCount; first += boxesPerChunk)
+    {
+        int n = Math::Min(boxesPerChunk, boxCount - first);
+
+        for (int i = 0; i < n; i++)
+            densify_box(bounds + 4 * (first + i), densifyPoints, srcLonAxis, &xs[i * perBox], &ys[i * perBox]);
+
+        int points = n * perBox;
+        if (srcLonAxis >= 0)
+            wrap_longitudes(srcLonAxis ? &ys[0] : &xs[0], points);
+
+        TransformBoundsPoints(forward, &xs[0], &ys[0], points);
+
+        for (int i = 0; i < n; i++)
+        {
+            double* box = bounds + 4 * (first + i);
+            double src[4] = { box[0], box[1], box[2], box[3] };
+
+            reduce_box(&xs[i * perBox], &ys[i * perBox], perBox, dstLonAxis, src, srcLonAxis, poles, box);
+        }
+    }
+
+    // Failed points leave an error on the transform
+    Context->ClearError(this);
+}
+
+double CoordinateTransform::DoTransformBoundsAdaptive(bool forward, double* box, double tolerance)
+{
+    const int initialSegments = 4; // Per edge
+
+    int srcLonAxis = lon_axis(forward ? SourceCRS : TargetCRS);
+    int dstLonAxis = lon_axis(forward ? TargetCRS : SourceCRS);
+
+    // Without pruning (geographic targets) every level may double the number of segments
+    const int maxDepth = (dstLonAxis < 0) ? 16 : 10;
+    const size_t maxPoints = 4096; // Hard limit on the number of transformed points
+
+    double poles[4];
+    TransformBoundsPoles(forward, dstLonAxis, poles);
+
+    // Start with the corners and a few points per edge
+    const int nInitial = 4 * initialSegments;
+    std::vector<double> sx(nInitial), sy(nInitial);
+    densify_box(box, initialSegments - 1, srcLonAxis, &sx[0], &sy[0]);
+
+    std::vector<double> xs(sx), ys(sy); // All transformed points
+    if (srcLonAxis >= 0)
+        wrap_longitudes(srcLonAxis ? &ys[0] : &xs[0], nInitial);
+    TransformBoundsPoints(forward, &xs[0], &ys[0], nInitial);
+
+    std::vector<bounds_segment> todo, next;
+    for (int i = 0; i < nInitial; i++)
+    {
+        int j = (i + 1) % nInitial;
+        bounds_segment sg = { { sx[i], sy[i], sx[j], sy[j] }, { xs[i], ys[i], xs[j], ys[j] }, 0 };
+        todo.push_back(sg);
+    }
+
+    double maxError = 0;
+    std::vector<double> mx, my;
+
+    while (todo.size())
+    {
+        // Transform the midpoints of all segments of this level at once
+        int n = (int)todo.size();
+        mx.resize(n);
+        my.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            mx[i] = (todo[i].s[0] + todo[i].s[2]) / 2;
+            my[i] = (todo[i].s[1] + todo[i].s[3]) / 2;
+        }
+
+        std::vector<double> smx(mx), smy(my);
+        if (srcLonAxis >= 0)
+            wrap_longitudes(srcLonAxis ? &my[0] : &mx[0], n);
+        TransformBoundsPoints(forward, &mx[0], &my[0], n);
+
+        for (int i = 0; i < n; i++)
+        {
+            xs.push_back(mx[i]);
+            ys.push_back(my[i]);
+        }
+
+        // Segments that can't reach the current bounds don't need more detail. (Not applied to geographic
+        // targets, where the longitude bounds may wrap)
+        double cur[4] = { HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+        if (dstLonAxis < 0)
+            bounds_of(&xs[0], &ys[0], (int)xs.size(), cur);
+
+        next.clear();
+        for (int i = 0; i < n; i++)
+        {
+            const bounds_segment& sg = todo[i];
+
+            // Both ends outside the domain of the transform: no edge to find here
+            if (!(std::isfinite(sg.t[0]) && std::isfinite(sg.t[1])) && !(std::isfinite(sg.t[2]) && std::isfinite(sg.t[3])))
+                continue;
+
+            double err = chord_error(&sg.t[0], &sg.t[2], mx[i], my[i], dstLonAxis);
+
+            if (err > tolerance && std::isfinite(err) && dstLonAxis < 0
+                && fmin(fmin(sg.t[0], sg.t[2]), mx[i]) - err > cur[0] && fmax(fmax(sg.t[0], sg.t[2]), mx[i]) + err < cur[2]
+                && fmin(fmin(sg.t[1], sg.t[3]), my[i]) - err > cur[1] && fmax(fmax(sg.t[1], sg.t[3]), my[i]) + err < cur[3])
+            {
+                continue;
+            }
+
+            // Segments with one end outside the domain have an infinite error, so they are bisected towards the edge of
+            // the domain. (The half with both ends outside is dropped on the next level)
+            if (err > tolerance && sg.depth < maxDepth && xs.size() + next.size() + 2 <= maxPoints)
+            {
+                bounds_segment a = { { sg.s[0], sg.s[1], smx[i], smy[i] }, { sg.t[0], sg.t[1], mx[i], my[i] }, sg.depth + 1 };
+                bounds_segment b = { { smx[i], smy[i], sg.s[2], sg.s[3] }, { mx[i], my[i], sg.t[2], sg.t[3] }, sg.depth + 1 };
+                next.push_back(a);
+                next.push_back(b);
+            }
+            else if (!(err <= maxError))
+                maxError = err; // HUGE_VAL when the edge of the domain was not resolved within the limits
+        }
+        todo.swap(next);
+    }
+
+    double src[4] = { box[0], box[1], box[2], box[3] };
+    bool ok = reduce_box(&xs[0], &ys[0], (int)xs.size(), dstLonAxis, src, srcLonAxis, poles, box);
+
+    Context->ClearError(this);
+    return ok ? maxError : std::nan("");
+}
+
+array<double>^ CoordinateTransform::TransformBounds(double minX, double minY, double maxX, double maxY, int densifyPoints)
+{
+    double box[4] = { minX, minY, maxX, maxY };
+
+    DoTransformBounds(true, box, 1, densifyPoints);
+
+    if (double::IsNaN(box[0]))
+        throw Context->ConstructException("Transform failed; Check Coordinates");
+
+    return gcnew array<double> { box[0], box[1], box[2], box[3] };
+}
+
+array<double>^ CoordinateTransform::TransformBoundsReversed(double minX, double minY, double maxX, double maxY, int densifyPoints)
+{
+    double box[4] = { minX, minY, maxX, maxY };
+
+    DoTransformBounds(false, box, 1, densifyPoints);
+
+    if (double::IsNaN(box[0]))
+        throw Context->ConstructException("Transform failed; Check Coordinates");
+
+    return gcnew array<double> { box[0], box[1], box[2], box[3] };
+}
+
+void CoordinateTransform::TransformBounds(array<double>^ bounds, int densifyPoints)
+{
+    if (!bounds)
+        throw gcnew ArgumentNullException("bounds");
+    else if (bounds->Length % 4)
+        throw gcnew ArgumentException("Bounds must be specified as 4 values per box", "bounds");
+    else if (!bounds->Length)
+        return;
+
+    pin_ptr<double> pBounds = &bounds[0];
+    DoTransformBounds(true, pBounds, bounds->Length / 4, densifyPoints);
+}
+
+void CoordinateTransform::TransformBoundsReversed(array<double>^ bounds, int densifyPoints)
+{
+    if (!bounds)
+        throw gcnew ArgumentNullException("bounds");
+    else if (bounds->Length % 4)
+        throw gcnew ArgumentException("Bounds must be specified as 4 values per box", "bounds");
+    else if (!bounds->Length)
+        return;
+
+    pin_ptr<double> pBounds = &bounds[0];
+    DoTransformBounds(false, pBounds, bounds->Length / 4, densifyPoints);
+}
+
+array<double>^ CoordinateTransform::TransformBounds(double minX, double minY, double maxX, double maxY, double tolerance, [Out] double% achievedError)
+{
+    if (!(tolerance > 0))
+        throw gcnew ArgumentOutOfRangeException("tolerance");
+
+    double box[4] = { minX, minY, maxX, maxY };
+
+    achievedError = DoTransformBoundsAdaptive(true, box, tolerance);
+
+    if (double::IsNaN(box[0]))
+        throw Context->ConstructException("Transform failed; Check Coordinates");
+
+    return gcnew array<double> { box[0], box[1], box[2], box[3] };
+}
+
+array<double>^ CoordinateTransform::TransformBoundsReversed(double minX, double minY, double maxX, double maxY, double tolerance, [Out] double% achievedError)
+{
+    if (!(tolerance > 0))
+        throw gcnew ArgumentOutOfRangeException("tolerance");
+
+    double box[4] = { minX, minY, maxX, maxY };
+
+    achievedError = DoTransformBoundsAdaptive(false, box, tolerance);
+
+    if (double::IsNaN(box[0]))
+        throw Context->ConstructException("Transform failed; Check Coordinates");
+
+    return gcnew array<double> { box[0], box[1], box[2], box[3] };
+}
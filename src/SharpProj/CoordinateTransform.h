@@ -6,8 +6,11 @@ extern "C" {
     struct geod_geodesic;
 };
 
+struct fast_pipeline;
+
 namespace SharpProj {
     ref class ChooseCoordinateTransform;
+    ref class ApproximateCoordinateTransform;
     ref class CoordinateTransform;
     ref class CoordinateReferenceSystem;
     ref class CoordinateArea;
@@ -117,6 +120,99 @@ namespace SharpProj {
             }
         };
 
+        /// <summary>
+        /// Receives the factors calculated by the batch overloads of <see cref="CoordinateTransform::Factors(PPoint)" />. Only the
+        /// components that have an array assigned are stored. Values that can't be calculated are set to NaN.
+        /// </summary>
+        public ref class CoordinateTransformFactorArrays
+        {
+        public:
+            property array<double>^ MeridionalScale;
+            property array<double>^ ParallelScale;
+            property array<double>^ ArealScale;
+            property array<double>^ AngularDistortion;
+            property array<double>^ MeridianParallelAngle;
+            property array<double>^ MeridianConvergence;
+            property array<double>^ TissotSemimajor;
+            property array<double>^ TissotSemiminor;
+            property array<double>^ DxDlam;
+            property array<double>^ DxDphi;
+            property array<double>^ DyDlam;
+            property array<double>^ DyDphi;
+
+        internal:
+            // In the order of the members of PJ_FACTORS
+            array<array<double>^>^ ToArray()
+            {
+                return gcnew array<array<double>^> {
+                    MeridionalScale, ParallelScale, ArealScale, AngularDistortion, MeridianParallelAngle, MeridianConvergence,
+                    TissotSemimajor, TissotSemiminor, DxDlam, DxDphi, DyDlam, DyDphi };
+            }
+        };
+
+        /// <summary>
+        /// The result of a batch <see cref="CoordinateTransform::RoundTrip(bool, int, PPoint)" />
+        /// </summary>
+        [DebuggerDisplay("Count={Count}, Max={Maximum}, Mean={Mean}")]
+        public ref class RoundTripStatistics sealed
+        {
+        private:
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            initonly array<double>^ m_errors;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            initonly array<double>^ m_sorted;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            initonly double m_mean;
+
+        internal:
+            RoundTripStatistics(array<double>^ errors);
+
+        public:
+            /// <summary>
+            /// The error of every coordinate, in the order of the input. NaN for coordinates that failed to transform.
+            /// </summary>
+            property array<double>^ Errors
+            {
+                array<double>^ get() { return m_errors; }
+            }
+
+            /// <summary>
+            /// The number of coordinates that were transformed successfully
+            /// </summary>
+            property int Count
+            {
+                int get() { return m_sorted->Length; }
+            }
+
+            /// <summary>
+            /// The number of coordinates that failed to transform
+            /// </summary>
+            property int FailedCount
+            {
+                int get() { return m_errors->Length - m_sorted->Length; }
+            }
+
+            property double Maximum
+            {
+                double get() { return m_sorted->Length ? m_sorted[m_sorted->Length - 1] : double::NaN; }
+            }
+
+            property double Mean
+            {
+                double get() { return m_mean; }
+            }
+
+            property double Median
+            {
+                double get() { return Percentile(50); }
+            }
+
+            /// <summary>
+            /// Gets the error below which <paramref name="percentage" /> percent of the successful coordinates fall (nearest rank)
+            /// </summary>
+            double Percentile(double percentage);
+        };
+
         [DebuggerDisplay("{Name,nq}={ValueString}")]
         public ref class CoordinateTransformParameter
         {
@@ -281,6 +377,12 @@ namespace SharpProj {
         struct geod_geodesic* m_pgeod;
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         ReadOnlyCollection<GridUsage^>^ m_gridUsages;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        fast_pipeline* m_fast;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        bool m_fastChecked;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        Proj::ProjOperationList^ m_projOperations;
 
 
     protected:
@@ -366,6 +468,51 @@ namespace SharpProj {
         /// <param name="ordinateArray"></param>
         void ApplyReversed(array<double, 2>^ ordinateArray);
 
+        /// <summary>
+        /// Transforms the bounding box (minX, minY, maxX, maxY) to the smallest box in the target CRS that contains
+        /// the transformed outline of the box. Each edge is densified with <paramref name="densifyPoints"/> points (default 21).
+        /// When the target CRS is geographic and the result crosses the antimeridian, the returned minimum longitude
+        /// is larger than the maximum longitude.
+        /// </summary>
+        /// <returns>The transformed bounds as { minX, minY, maxX, maxY }</returns>
+        array<double>^ TransformBounds(double minX, double minY, double maxX, double maxY, [Optional] int densifyPoints);
+        /// <summary>
+        /// Transforms the bounding box (minX, minY, maxX, maxY) backwards. See <see cref="TransformBounds(double, double, double, double, int)"/>
+        /// </summary>
+        array<double>^ TransformBoundsReversed(double minX, double minY, double maxX, double maxY, [Optional] int densifyPoints);
+        /// <summary>
+        /// Transforms a series of bounding boxes in-place, stored as (minX, minY, maxX, maxY) per box. All densified edge points
+        /// are transformed in bulk. Boxes that can't be transformed are set to NaN.
+        /// </summary>
+        void TransformBounds(array<double>^ bounds, [Optional] int densifyPoints);
+        /// <summary>
+        /// Transforms a series of bounding boxes backwards in-place. See <see cref="TransformBounds(array{double}, int)"/>
+        /// </summary>
+        void TransformBoundsReversed(array<double>^ bounds, [Optional] int densifyPoints);
+
+        /// <summary>
+        /// Transforms the bounding box (minX, minY, maxX, maxY) like <see cref="TransformBounds(double, double, double, double, int)"/>,
+        /// but subdivides the edges only where the transformed edge deviates more than <paramref name="tolerance"/> (in target units)
+        /// from a straight line. Refinement stops at a fixed depth and after 4096 transformed points, in which case
+        /// <paramref name="achievedError"/> may exceed the tolerance.
+        /// </summary>
+        /// <param name="achievedError">Receives the largest remaining deviation of the accepted edge segments. Positive infinity
+        /// when an edge crosses the boundary of the area where the transform is valid, as the error can't be determined there</param>
+        array<double>^ TransformBounds(double minX, double minY, double maxX, double maxY, double tolerance, [Out] double% achievedError);
+        /// <summary>
+        /// Transforms the bounding box (minX, minY, maxX, maxY) backwards with adaptive edge densification.
+        /// See <see cref="TransformBounds(double, double, double, double, double, double%)"/>
+        /// </summary>
+        array<double>^ TransformBoundsReversed(double minX, double minY, double maxX, double maxY, double tolerance, [Out] double% achievedError);
+
+    internal:
+        void TransformBoundsPoints(bool forward, double* xs, double* ys, int count);
+
+    private:
+        void TransformBoundsPoles(bool forward, int dstLonAxis, double* poles);
+        void DoTransformBounds(bool forward, double* bounds, int boxCount, int densifyPoints);
+        double DoTransformBoundsAdaptive(bool forward, double* box, double tolerance);
+
     protected:
         /// <summary>
         /// Implements <see cref="Apply(PPoint)" /> and <see cref="ApplyReversed(PPoint)" />
@@ -386,6 +533,37 @@ namespace SharpProj {
     internal:
         PPoint FromCoordinate(const PJ_COORD& coord, bool forward);
 
+    private:
+        void EnsureFastPath();
+        void ReleaseFastPath();
+
+    internal:
+        // Parsed PROJ string of this transform, created once and shared by all callers
+        property Proj::ProjOperationList^ OperationList
+        {
+            Proj::ProjOperationList^ get();
+        }
+
+    internal:
+        bool TryFastTransform(bool forward,
+            double* xVals, int xStep, int xCount,
+            double* yVals, int yStep, int yCount,
+            double* zVals, int zStep, int zCount,
+            double* tVals, int tStep, int tCount);
+
+    public:
+        /// <summary>
+        /// Gets a boolean indicating whether range transforms use a native implementation instead of PROJ. This is the case for
+        /// pipelines that only contain axis swaps, unit conversions, UTM or Transverse Mercator (lat_0=0) with
+        /// algo=poder_engsager, and Web Mercator on the WGS84 or GRS80 ellipsoid, after the implementation matched PROJ on a grid
+        /// of test coordinates. Coordinates outside the safe domain of the native implementation are still transformed by PROJ.
+        /// </summary>
+        [EditorBrowsable(EditorBrowsableState::Advanced)]
+        property bool HasFastPath
+        {
+            virtual bool get();
+        }
+
     public:
         CoordinateTransform^ Clone([Optional]ProjContext^ ctx) new
         {
@@ -526,6 +704,9 @@ namespace SharpProj {
     public:
         void SetupDistance();
 
+    private:
+        void GeoTransform(System::Collections::Generic::IEnumerable<PPoint>^ points, array<double>^% xs, array<double>^% ys, array<double>^% zs);
+
     public:
         /// <summary>
         /// When called on an instance obtained from CoordinateRefenceSystem.DistanceTransform calculates the distance in meters
@@ -624,6 +805,18 @@ namespace SharpProj {
         /// <returns></returns>
         double RoundTrip(bool forward, int transforms, array<double>^ ordinates) { return RoundTrip(forward, transforms, PPoint(ordinates)); }
         /// <summary>
+        /// Measures the internal consistency of this transformation for all coordinates (xValues[i], yValues[i], zValues[i]). Like
+        /// <see cref="RoundTrip(bool, int, PPoint)" /> every coordinate is transformed <paramref name="transforms" /> times back and forth.
+        /// Large batches are divided over multiple threads, that each use their own copy of this transform.
+        /// </summary>
+        /// <param name="forward"></param>
+        /// <param name="transforms"></param>
+        /// <param name="xValues"></param>
+        /// <param name="yValues"></param>
+        /// <param name="zValues">Optional heights, assumed 0 when not passed</param>
+        /// <returns>The error of every coordinate and statistics over these errors</returns>
+        Proj::RoundTripStatistics^ RoundTrip(bool forward, int transforms, array<double>^ xValues, array<double>^ yValues, [Optional] array<double>^ zValues);
+        /// <summary>
         /// Calculate various cartographic properties, such as scale factors, angular distortion and meridian convergence. Depending on the underlying projection values will be calculated either numerically (default) or analytically.
         /// </summary>
         /// <param name="coordinate"></param>
@@ -635,6 +828,30 @@ namespace SharpProj {
         /// <param name="ordinates"></param>
         /// <returns></returns>
         Proj::CoordinateTransformFactors^ Factors(array<double>^ ordinates) { return Factors(PPoint(ordinates)); }
+        /// <summary>
+        /// Calculates the factors for all points (xValues[i], yValues[i]) and stores the requested components in <paramref name="factors" />.
+        /// Large batches are divided over multiple threads, that each use their own copy of this transform.
+        /// </summary>
+        /// <param name="xValues"></param>
+        /// <param name="yValues"></param>
+        /// <param name="factors">The arrays receiving the factor components. Each assigned array must have at least as many items as xValues</param>
+        void Factors(array<double>^ xValues, array<double>^ yValues, Proj::CoordinateTransformFactorArrays^ factors);
+        /// <summary>
+        /// Calculates the factors for a grid of <paramref name="columns" /> by <paramref name="rows" /> points, starting at (minX, minY) and
+        /// stores the requested components in <paramref name="factors" />. The point at (column, row) is stored at index row * columns + column.
+        /// </summary>
+        void Factors(double minX, double minY, double stepX, double stepY, int columns, int rows, Proj::CoordinateTransformFactorArrays^ factors);
+
+        /// <summary>
+        /// Creates an approximation of this transform that interpolates forward transforms inside the area (minX, minY)-(maxX, maxY)
+        /// in source coordinates, within <paramref name="maxError" /> in target units at the points the approximation checks
+        /// (see <see cref="ApproximateCoordinateTransform" />). Coordinates that can't be interpolated
+        /// are transformed by this instance, which must stay alive while the approximation is used.
+        /// </summary>
+        ApproximateCoordinateTransform^ CreateApproximation(double minX, double minY, double maxX, double maxY, double maxError);
+
+    private:
+        void DoFactors(const double* xs, const double* ys, double minX, double minY, double stepX, double stepY, int columns, int count, Proj::CoordinateTransformFactorArrays^ factors);
 
 
     public:
@@ -12,6 +12,8 @@ namespace SharpProj {
     private:
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         array<CoordinateTransform^>^ m_steps;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        IReadOnlyList<ProjOperation^>^ m_allOperations;
 
     internal:
         CoordinateTransformList(ProjContext^ ctx, PJ* pj);
@@ -67,8 +69,12 @@ namespace SharpProj {
 
         virtual IReadOnlyList<ProjOperation^>^ ProjOperations() override
         {
-            auto ops = System::Linq::Enumerable::SelectMany<CoordinateTransform^, ProjOperation^>(this, gcnew System::Func<CoordinateTransform^, IEnumerable<ProjOperation^>^>(&Select_Steps));
-            return System::Linq::Enumerable::ToList(ops)->AsReadOnly();
+            if (!m_allOperations)
+            {
+                auto ops = System::Linq::Enumerable::SelectMany<CoordinateTransform^, ProjOperation^>(this, gcnew System::Func<CoordinateTransform^, IEnumerable<ProjOperation^>^>(&Select_Steps));
+                m_allOperations = System::Linq::Enumerable::ToList(ops)->AsReadOnly();
+            }
+            return m_allOperations;
         }
 
         virtual CoordinateTransform^ CreateInverse([Optional]ProjContext^ ctx) override
@@ -0,0 +1,812 @@
+#include "pch.h"
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "BatchKernels.h"
+#include "CoordinateTransform.h"
+#include "ProjOperation.h"
+
+#pragma managed(push, off)
+enum class fast_step_kind { swap_xy, scale_xy, webmerc, tmerc };
+
+struct fast_step
+{
+    fast_step_kind kind;
+    bool inverse;       // The step is applied inverted in the forward direction of the pipeline
+    double factor;      // scale_xy: input unit to output unit
+    double a, k0, lam0, x0, y0;
+    double e, A, alpha[6], beta[6];
+};
+
+// Native version of a pipeline that only contains steps from a small set of common operations
+struct fast_pipeline
+{
+    std::vector<fast_step> steps;
+};
+
+namespace {
+    const int FAST_MIN_COUNT = 32;
+    const int FAST_BLOCK = 256;
+    const double FAST_PI = 3.14159265358979323846;
+    const double FAST_DEG_TO_RAD = 0.017453292519943296;
+    // Beyond these limits coordinates are left to PROJ
+    const double FAST_MAX_LAT = 89.0 * FAST_DEG_TO_RAD;
+    const double FAST_MAX_TMERC_LAM = 40.0 * FAST_DEG_TO_RAD;
+
+    // Unit of the coordinates between two steps
+    struct fast_unit
+    {
+        bool known;
+        bool angular;
+        double factor; // To radians or meters
+    };
+
+    // Like PROJ's adjlon(): brings a longitude in [-pi, pi]
+    inline double fast_adjlon(double lon)
+    {
+        if (std::fabs(lon) < FAST_PI + 1e-12)
+            return lon;
+
+        lon += FAST_PI;
+        lon -= 2 * FAST_PI * std::floor(lon / (2 * FAST_PI));
+        return lon - FAST_PI;
+    }
+
+    // Transverse Mercator with the 6th order Krüger series (Karney, 2011), like PROJ's algo=poder_engsager. (PROJ's default
+    // algo=auto uses the Evenden/Snyder approximation within 3 degrees of the central meridian)
+    void init_tmerc(fast_step& s, double a, double f, double k0, double lam0, double x0, double y0)
+    {
+        double n = f / (2 - f);
+        double n2 = n * n, n3 = n2 * n, n4 = n3 * n, n5 = n4 * n, n6 = n5 * n;
+
+        s.kind = fast_step_kind::tmerc;
+        s.a = a;
+        s.k0 = k0;
+        s.lam0 = lam0;
+        s.x0 = x0;
+        s.y0 = y0;
+        s.e = std::sqrt(f * (2 - f));
+        s.A = a / (1 + n) * (1 + n2 / 4 + n4 / 64 + n6 / 256);
+
+        s.alpha[0] = n / 2 - 2 * n2 / 3 + 5 * n3 / 16 + 41 * n4 / 180 - 127 * n5 / 288 + 7891 * n6 / 37800;
+        s.alpha[1] = 13 * n2 / 48 - 3 * n3 / 5 + 557 * n4 / 1440 + 281 * n5 / 630 - 1983433 * n6 / 1935360;
+        s.alpha[2] = 61 * n3 / 240 - 103 * n4 / 140 + 15061 * n5 / 26880 + 167603 * n6 / 181440;
+        s.alpha[3] = 49561 * n4 / 161280 - 179 * n5 / 168 + 6601661 * n6 / 7257600;
+        s.alpha[4] = 34729 * n5 / 80640 - 3418889 * n6 / 1995840;
+        s.alpha[5] = 212378941 * n6 / 319334400;
+
+        s.beta[0] = n / 2 - 2 * n2 / 3 + 37 * n3 / 96 - n4 / 360 - 81 * n5 / 512 + 96199 * n6 / 604800;
+        s.beta[1] = n2 / 48 + n3 / 15 - 437 * n4 / 1440 + 46 * n5 / 105 - 1118711 * n6 / 3870720;
+        s.beta[2] = 17 * n3 / 480 - 37 * n4 / 840 - 209 * n5 / 4480 + 5569 * n6 / 90720;
+        s.beta[3] = 4397 * n4 / 161280 - 11 * n5 / 504 - 830251 * n6 / 7257600;
+        s.beta[4] = 4583 * n5 / 161280 - 108847 * n6 / 3991680;
+        s.beta[5] = 20648693 * n6 / 638668800;
+    }
+
+    bool tmerc_fwd(const fast_step& s, double& x, double& y)
+    {
+        double lam = fast_adjlon(x - s.lam0);
+        double phi = y;
+
+        if (!(std::fabs(phi) <= FAST_MAX_LAT && std::fabs(lam) <= FAST_MAX_TMERC_LAM))
+            return false;
+
+        double sphi = std::sin(phi);
+        double tau = std::sinh(std::atanh(sphi) - s.e * std::atanh(s.e * sphi));
+        double xip = std::atan2(tau, std::cos(lam));
+        double etap = std::atanh(std::sin(lam) / std::sqrt(1 + tau * tau));
+        double xi = xip, eta = etap;
+
+        for (int j = 0; j < 6; j++)
+        {
+            double k = 2.0 * (j + 1);
+            xi += s.alpha[j] * std::sin(k * xip) * std::cosh(k * etap);
+            eta += s.alpha[j] * std::cos(k * xip) * std::sinh(k * etap);
+        }
+
+        x = s.k0 * s.A * eta + s.x0;
+        y = s.k0 * s.A * xi + s.y0;
+        return true;
+    }
+
+    bool tmerc_inv(const fast_step& s, double& x, double& y)
+    {
+        double xi = (y - s.y0) / (s.k0 * s.A);
+        double eta = (x - s.x0) / (s.k0 * s.A);
+
+        if (!(std::fabs(eta) <= 0.8 && std::fabs(xi) <= 1.55))
+            return false;
+
+        double xip = xi, etap = eta;
+
+        for (int j = 0; j < 6; j++)
+        {
+            double k = 2.0 * (j + 1);
+            xip -= s.beta[j] * std::sin(k * xi) * std::cosh(k * eta);
+            etap -= s.beta[j] * std::cos(k * xi) * std::sinh(k * eta);
+        }
+
+        double shetap = std::sinh(etap);
+        double cxip = std::cos(xip);
+        double taup = std::sin(xip) / std::sqrt(shetap * shetap + cxip * cxip);
+        double lam = std::atan2(shetap, cxip);
+
+        // Newton iteration for the latitude from the conformal latitude
+        double e2m = 1 - s.e * s.e;
+        double tau = taup / e2m;
+
+        for (int i = 0; i < 5; i++)
+        {
+            double tau1 = std::sqrt(1 + tau * tau);
+            double sig = std::sinh(s.e * std::atanh(s.e * tau / tau1));
+            double taupa = std::sqrt(1 + sig * sig) * tau - sig * tau1;
+            double dtau = (taup - taupa) / std::sqrt(1 + taupa * taupa) * (1 + e2m * tau * tau) / (e2m * tau1);
+
+            tau += dtau;
+
+            if (!(std::fabs(dtau) >= 1e-14 * std::fmax(1.0, std::fabs(tau))))
+                break;
+        }
+
+        double phi = std::atan(tau);
+
+        if (!(std::fabs(phi) <= FAST_MAX_LAT))
+            return false;
+
+        x = fast_adjlon(lam + s.lam0);
+        y = phi;
+        return true;
+    }
+
+    // Web Mercator: spherical Mercator on the semi major axis
+    bool webmerc_fwd(const fast_step& s, double& x, double& y)
+    {
+        double lam = fast_adjlon(x - s.lam0);
+        double phi = y;
+
+        if (!(std::fabs(phi) <= FAST_MAX_LAT))
+            return false;
+
+        x = s.a * lam + s.x0;
+        y = s.a * std::asinh(std::tan(phi)) + s.y0;
+        return true;
+    }
+
+    bool webmerc_inv(const fast_step& s, double& x, double& y)
+    {
+        double phi = std::atan(std::sinh((y - s.y0) / s.a));
+
+        if (!(std::fabs(phi) <= FAST_MAX_LAT) || !std::isfinite(x))
+            return false;
+
+        x = fast_adjlon((x - s.x0) / s.a + s.lam0);
+        y = phi;
+        return true;
+    }
+
+    inline bool fast_step_apply(const fast_step& s, bool inverse, double& x, double& y)
+    {
+        switch (s.kind)
+        {
+        case fast_step_kind::swap_xy:
+            std::swap(x, y);
+            return true;
+        case fast_step_kind::scale_xy:
+            if (inverse)
+            {
+                x /= s.factor;
+                y /= s.factor;
+            }
+            else
+            {
+                x *= s.factor;
+                y *= s.factor;
+            }
+            return true;
+        case fast_step_kind::webmerc:
+            return inverse ? webmerc_inv(s, x, y) : webmerc_fwd(s, x, y);
+        case fast_step_kind::tmerc:
+            return inverse ? tmerc_inv(s, x, y) : tmerc_fwd(s, x, y);
+        default:
+            return false;
+        }
+    }
+
+    // Runs the steps over a block of contiguous coordinates. Axis swaps just swap the buffers, so x and y receive the
+    // buffers holding the result. ok[i] is cleared for coordinates a step can't handle.
+    template<bool Forward>
+    void fast_block(const fast_pipeline& p, double*& x, double*& y, bool* ok, int n)
+    {
+        int count = (int)p.steps.size();
+
+        for (int k = 0; k < count; k++)
+        {
+            const fast_step& s = p.steps[Forward ? k : count - 1 - k];
+            bool inverse = Forward ? s.inverse : !s.inverse;
+
+            switch (s.kind)
+            {
+            case fast_step_kind::swap_xy:
+                std::swap(x, y);
+                break;
+            case fast_step_kind::scale_xy:
+                batch_scale(x, n, inverse ? 1 / s.factor : s.factor);
+                batch_scale(y, n, inverse ? 1 / s.factor : s.factor);
+                break;
+            default:
+                for (int i = 0; i < n; i++)
+                {
+                    if (ok[i] && !fast_step_apply(s, inverse, x[i], y[i]))
+                        ok[i] = false;
+                }
+                break;
+            }
+        }
+    }
+
+    // Transforms all coordinates it can in place and returns the indexes of the others, which are left untouched
+    template<bool Forward>
+    void fast_apply(const fast_pipeline& p, double* xs, int xStep, double* ys, int yStep, int count, std::vector<int>& missed)
+    {
+        double bx[FAST_BLOCK], by[FAST_BLOCK], ox[FAST_BLOCK], oy[FAST_BLOCK];
+        bool ok[FAST_BLOCK];
+        // Both ordinates in one buffer, like array<double, 2>
+        bool interleaved = (ys == xs + 1 && xStep == yStep && xStep >= 2);
+
+        for (int start = 0; start < count; start += FAST_BLOCK)
+        {
+            int n = std::min(FAST_BLOCK, count - start);
+            double* px = xs + (size_t)start * xStep;
+            double* py = ys + (size_t)start * yStep;
+
+            if (interleaved)
+                batch_deinterleave(px, xStep, n, bx, by);
+            else
+            {
+                batch_gather(px, xStep, n, bx);
+                batch_gather(py, yStep, n, by);
+            }
+            memcpy(ox, bx, n * sizeof(double));
+            memcpy(oy, by, n * sizeof(double));
+            std::fill(ok, ok + n, true);
+
+            double* rx = bx;
+            double* ry = by;
+            fast_block<Forward>(p, rx, ry, ok, n);
+
+            for (int i = 0; i < n; i++)
+            {
+                if (!ok[i])
+                {
+                    rx[i] = ox[i];
+                    ry[i] = oy[i];
+                    missed.push_back(start + i);
+                }
+            }
+
+            if (interleaved)
+                batch_interleave(rx, ry, n, px, xStep);
+            else
+            {
+                batch_scatter(rx, n, px, xStep);
+                batch_scatter(ry, n, py, yStep);
+            }
+        }
+    }
+
+    double fast_tolerance(const fast_unit& u)
+    {
+        if (!u.known)
+            return 1e-9;
+
+        return (u.angular ? 1e-12 : 1e-6) / u.factor;
+    }
+
+    // Compares the fast path with PROJ in both directions on a grid of geographic coordinates (in radians) that is placed
+    // at the step boundary 'anchor' and moved back to the input of the pipeline
+    bool fast_verify(PJ* pj, const fast_pipeline& p, size_t anchor, double lonMin, double lonMax, double latMin, double latMax, double inTolerance, double outTolerance)
+    {
+        const int n = 9;
+        std::vector<double> xs, ys;
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double x = lonMin + (lonMax - lonMin) * i / (n - 1);
+                double y = latMin + (latMax - latMin) * j / (n - 1);
+                bool ok = true;
+
+                for (size_t k = anchor; ok && k > 0; k--)
+                {
+                    const fast_step& s = p.steps[k - 1];
+                    ok = fast_step_apply(s, !s.inverse, x, y);
+                }
+
+                if (ok)
+                {
+                    xs.push_back(x);
+                    ys.push_back(y);
+                }
+            }
+        }
+
+        int count = (int)xs.size();
+        std::vector<double> fx(xs), fy(ys);
+        std::vector<int> missed;
+        std::vector<bool> skip(count);
+
+        fast_apply<true>(p, fx.data(), 1, fy.data(), 1, count, missed);
+        for (int i : missed)
+            skip[i] = true;
+
+        std::vector<double> rx(count), ry(count);
+        for (int i = 0; i < count; i++)
+        {
+            PJ_COORD r = proj_trans(pj, PJ_FWD, proj_coord(xs[i], ys[i], 0, 0));
+
+            rx[i] = r.v[0];
+            ry[i] = r.v[1];
+
+            if (!skip[i] && !(std::fabs(rx[i] - fx[i]) <= outTolerance && std::fabs(ry[i] - fy[i]) <= outTolerance))
+                return false;
+        }
+
+        std::vector<double> bx(rx), by(ry);
+        missed.clear();
+        fast_apply<false>(p, bx.data(), 1, by.data(), 1, count, missed);
+        for (int i : missed)
+            skip[i] = true;
+
+        int checked = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (skip[i])
+                continue;
+
+            PJ_COORD b = proj_trans(pj, PJ_INV, proj_coord(rx[i], ry[i], 0, 0));
+
+            if (!(std::fabs(b.v[0] - bx[i]) <= inTolerance && std::fabs(b.v[1] - by[i]) <= inTolerance))
+                return false;
+
+            checked++;
+        }
+
+        return checked > 0;
+    }
+}
+
+// Transforms contiguous coordinates with the fast path when available, and all other coordinates with PROJ.
+// Used by the batch operations that run on cloned PJs on other threads
+void fast_trans_generic(PJ* pj, const fast_pipeline* p, PJ_DIRECTION dir, double* xs, double* ys, double* zs, int count)
+{
+    std::vector<int> missed;
+
+    if (!p || count < FAST_MIN_COUNT)
+    {
+        proj_trans_generic(pj, dir, xs, sizeof(double), count, ys, sizeof(double), count, zs, sizeof(double), zs ? count : 0, nullptr, 0, 0);
+        return;
+    }
+
+    if (dir == PJ_FWD)
+        fast_apply<true>(*p, xs, 1, ys, 1, count, missed);
+    else
+        fast_apply<false>(*p, xs, 1, ys, 1, count, missed);
+
+    if (missed.empty())
+        return;
+
+    int n = (int)missed.size();
+    std::vector<double> gx(n), gy(n), gz(zs ? n : 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        gx[i] = xs[missed[i]];
+        gy[i] = ys[missed[i]];
+        if (zs)
+            gz[i] = zs[missed[i]];
+    }
+
+    proj_trans_generic(pj, dir, gx.data(), sizeof(double), n, gy.data(), sizeof(double), n, zs ? gz.data() : nullptr, sizeof(double), zs ? n : 0, nullptr, 0, 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        xs[missed[i]] = gx[i];
+        ys[missed[i]] = gy[i];
+        if (zs)
+            zs[missed[i]] = gz[i];
+    }
+}
+#pragma managed(pop)
+
+using namespace SharpProj;
+using namespace SharpProj::Proj;
+using System::Collections::Generic::Dictionary;
+
+static Dictionary<String^, String^>^ fast_params(ProjOperation^ op)
+{
+    Dictionary<String^, String^>^ d = gcnew Dictionary<String^, String^>();
+
+    for each (String ^ t in op->Tokens)
+    {
+        int eq = t->IndexOf('=');
+        String^ key = (eq >= 0) ? t->Substring(0, eq) : t;
+
+        if (d->ContainsKey(key))
+            return nullptr;
+
+        d[key] = (eq >= 0) ? t->Substring(eq + 1) : String::Empty;
+    }
+    return d;
+}
+
+// Checks that the step has no other parameters than the ones the fast implementation handles
+static bool fast_allowed(Dictionary<String^, String^>^ d, ...array<String^>^ keys)
+{
+    for each (String ^ key in d->Keys)
+    {
+        if (key != "proj" && key != "inv" && Array::IndexOf(keys, key) < 0)
+            return false;
+    }
+    return true;
+}
+
+static bool fast_number(Dictionary<String^, String^>^ d, String^ key, double defaultValue, double% value)
+{
+    String^ v;
+
+    if (!d->TryGetValue(key, v))
+    {
+        value = defaultValue;
+        return true;
+    }
+
+    return double::TryParse(v, System::Globalization::NumberStyles::Float, System::Globalization::CultureInfo::InvariantCulture, value)
+        && !double::IsNaN(value) && !double::IsInfinity(value);
+}
+
+static bool fast_ellipsoid(Dictionary<String^, String^>^ d, double% a, double% f)
+{
+    String^ ellps;
+    String^ units;
+
+    if (d->TryGetValue("units", units) && units != "m")
+        return false;
+
+    if (!d->TryGetValue("ellps", ellps))
+        ellps = "GRS80"; // PROJ's default
+
+    a = 6378137.0;
+    if (ellps == "WGS84")
+        f = 1 / 298.257223563;
+    else if (ellps == "GRS80")
+        f = 1 / 298.257222101;
+    else
+        return false;
+
+    return true;
+}
+
+// The native Transverse Mercator implements the exact algorithm. PROJ's default algo=auto uses the Evenden/Snyder
+// approximation within 3 degrees of the central meridian, so only take over when the exact algorithm is requested
+static bool fast_tmerc_algo(Dictionary<String^, String^>^ d)
+{
+    String^ algo;
+
+    return d->TryGetValue("algo", algo) && algo == "poder_engsager";
+}
+
+static bool fast_unit_of(String^ name, fast_unit& u)
+{
+    u.known = true;
+    if (name == "deg")
+    {
+        u.angular = true;
+        u.factor = FAST_DEG_TO_RAD;
+    }
+    else if (name == "rad")
+    {
+        u.angular = true;
+        u.factor = 1;
+    }
+    else if (name == "grad")
+    {
+        u.angular = true;
+        u.factor = FAST_PI / 200;
+    }
+    else if (name == "m")
+    {
+        u.angular = false;
+        u.factor = 1;
+    }
+    else if (name == "km")
+    {
+        u.angular = false;
+        u.factor = 1000;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+// Translates one step of the pipeline; returns false when the step has no fast implementation. Steps without effect
+// are not added. uIn and uOut receive the units before and after the step, when the step defines them.
+static bool fast_translate(ProjOperation^ op, std::vector<fast_step>& steps, fast_unit& uIn, fast_unit& uOut)
+{
+    Dictionary<String^, String^>^ d = fast_params(op);
+    String^ name;
+
+    if (!d || !d->TryGetValue("proj", name))
+        return false;
+
+    fast_step s = {};
+    s.inverse = d->ContainsKey("inv");
+    uIn.known = uOut.known = false;
+
+    if (name == "noop")
+        return fast_allowed(d);
+    else if (name == "axisswap")
+    {
+        String^ order;
+
+        if (!fast_allowed(d, "order") || !d->TryGetValue("order", order)
+            || (order != "2,1" && order != "2,1,3" && order != "2,1,3,4"))
+        {
+            return false;
+        }
+
+        s.kind = fast_step_kind::swap_xy;
+    }
+    else if (name == "unitconvert")
+    {
+        String^ xyIn;
+        String^ xyOut;
+        String^ zIn;
+        String^ zOut;
+        fast_unit fin, fout;
+
+        if (!fast_allowed(d, "xy_in", "xy_out", "z_in", "z_out")
+            || !d->TryGetValue("xy_in", xyIn) || !d->TryGetValue("xy_out", xyOut)
+            || !fast_unit_of(xyIn, fin) || !fast_unit_of(xyOut, fout) || fin.angular != fout.angular)
+        {
+            return false;
+        }
+
+        // Z must pass unchanged
+        d->TryGetValue("z_in", zIn);
+        d->TryGetValue("z_out", zOut);
+        if (zIn != zOut)
+            return false;
+
+        s.kind = fast_step_kind::scale_xy;
+        s.factor = fin.factor / fout.factor;
+        uIn = s.inverse ? fout : fin;
+        uOut = s.inverse ? fin : fout;
+    }
+    else if (name == "webmerc")
+    {
+        double a, f, lat0, lon0, x0, y0, k0;
+
+        if (!fast_allowed(d, "lat_0", "lon_0", "x_0", "y_0", "k", "k_0", "ellps", "units", "no_defs")
+            || !fast_ellipsoid(d, a, f)
+            || !fast_number(d, "lat_0", 0, lat0) || lat0 != 0
+            || !fast_number(d, "lon_0", 0, lon0)
+            || !fast_number(d, "x_0", 0, x0)
+            || !fast_number(d, "y_0", 0, y0)
+            || !fast_number(d, "k", 1, k0) || k0 != 1
+            || !fast_number(d, "k_0", 1, k0) || k0 != 1)
+        {
+            return false;
+        }
+
+        s.kind = fast_step_kind::webmerc;
+        s.a = a;
+        s.lam0 = lon0 * FAST_DEG_TO_RAD;
+        s.x0 = x0;
+        s.y0 = y0;
+    }
+    else if (name == "utm")
+    {
+        double a, f, zone;
+
+        if (!fast_allowed(d, "zone", "south", "ellps", "units", "no_defs", "algo")
+            || !fast_tmerc_algo(d)
+            || !fast_ellipsoid(d, a, f)
+            || !d->ContainsKey("zone") || !fast_number(d, "zone", 0, zone)
+            || zone < 1 || zone > 60 || zone != Math::Floor(zone))
+        {
+            return false;
+        }
+
+        init_tmerc(s, a, f, 0.9996, ((zone - 1) * 6 - 180 + 3) * FAST_DEG_TO_RAD, 500000, d->ContainsKey("south") ? 10000000 : 0);
+    }
+    else if (name == "tmerc")
+    {
+        double a, f, lat0, lon0, x0, y0, k0;
+
+        if (!fast_allowed(d, "lat_0", "lon_0", "x_0", "y_0", "k", "k_0", "ellps", "units", "no_defs", "algo")
+            || !fast_tmerc_algo(d)
+            || (d->ContainsKey("k") && d->ContainsKey("k_0"))
+            || !fast_ellipsoid(d, a, f)
+            || !fast_number(d, "lat_0", 0, lat0) || lat0 != 0
+            || !fast_number(d, "lon_0", 0, lon0)
+            || !fast_number(d, "x_0", 0, x0)
+            || !fast_number(d, "y_0", 0, y0)
+            || !fast_number(d, d->ContainsKey("k_0") ? (String^)"k_0" : (String^)"k", 1, k0) || !(k0 > 0))
+        {
+            return false;
+        }
+
+        init_tmerc(s, a, f, k0, lon0 * FAST_DEG_TO_RAD, x0, y0);
+    }
+    else
+        return false;
+
+    if (s.kind == fast_step_kind::webmerc || s.kind == fast_step_kind::tmerc)
+    {
+        fast_unit geo = { true, true, 1 };
+        fast_unit linear = { true, false, 1 };
+
+        uIn = s.inverse ? linear : geo;
+        uOut = s.inverse ? geo : linear;
+    }
+
+    steps.push_back(s);
+    return true;
+}
+
+void CoordinateTransform::EnsureFastPath()
+{
+    m_fastChecked = true;
+
+    ProjOperationList^ ops = OperationList;
+    ops->Ensure();
+
+    // Pipeline wide parameters apply to every step
+    if (!ops->Count || ops->CommonTokens->Count)
+    {
+        Context->ClearError(this);
+        return;
+    }
+
+    fast_pipeline p;
+    fast_unit uIn = {}, uOut = {};
+    int projStep = -1;
+
+    for each (ProjOperation ^ op in ops)
+    {
+        fast_unit si = {}, so = {};
+
+        if (!fast_translate(op, p.steps, si, so))
+            return;
+
+        if (si.known && !uIn.known)
+            uIn = si;
+        if (so.known)
+            uOut = so;
+
+        // Only projections change between angular and linear units
+        if (projStep < 0 && si.known && so.known && si.angular != so.angular)
+            projStep = (int)p.steps.size() - 1;
+    }
+
+    if (p.steps.empty())
+        return;
+
+    bool ok;
+    if (projStep >= 0)
+    {
+        // Sample the whole domain the kernels accept, on the geographic side of the first projection
+        const fast_step& s = p.steps[projStep];
+        size_t anchor = s.inverse ? projStep + 1 : projStep;
+        double range = (s.kind == fast_step_kind::tmerc) ? FAST_MAX_TMERC_LAM / FAST_DEG_TO_RAD : 160;
+        double lat = 85;
+
+        ok = fast_verify(this, p, anchor,
+            s.lam0 - range * FAST_DEG_TO_RAD, s.lam0 + range * FAST_DEG_TO_RAD,
+            -lat * FAST_DEG_TO_RAD, lat * FAST_DEG_TO_RAD,
+            fast_tolerance(uIn), fast_tolerance(uOut));
+    }
+    else
+    {
+        // Only axis swaps and unit conversions. Sample in the input unit
+        double scale = !uIn.known ? 1 : (uIn.angular ? 1 / uIn.factor : 1e5 / uIn.factor);
+
+        ok = fast_verify(this, p, 0, -3 * scale, 3 * scale, -1.5 * scale, 1.5 * scale,
+            fast_tolerance(uIn), fast_tolerance(uOut));
+    }
+
+    Context->ClearError(this);
+
+    if (ok)
+    {
+        m_fast = new fast_pipeline(std::move(p));
+        Context->OnLogMessage(ProjLogLevel::Debug, "Using native fast path for " + String::Join(" ", ops->Tokens));
+    }
+    else
+        Context->OnLogMessage(ProjLogLevel::Debug, "Native fast path doesn't match PROJ for " + String::Join(" ", ops->Tokens));
+}
+
+void CoordinateTransform::ReleaseFastPath()
+{
+    if (m_fast)
+    {
+        delete m_fast;
+        m_fast = nullptr;
+    }
+}
+
+bool CoordinateTransform::HasFastPath::get()
+{
+    if (!m_fastChecked)
+        EnsureFastPath();
+
+    return m_fast != nullptr;
+}
+
+bool CoordinateTransform::TryFastTransform(bool forward,
+    double* xVals, int xStep, int xCount,
+    double* yVals, int yStep, int yCount,
+    double* zVals, int zStep, int zCount,
+    double* tVals, int tStep, int tCount)
+{
+    if (xCount < FAST_MIN_COUNT || xCount != yCount || !xVals || !yVals || xStep < 1 || yStep < 1)
+        return false;
+
+    // Leave the broadcasting rules of shorter z and t arrays to PROJ
+    bool zFull = zVals && zCount >= xCount;
+    bool tFull = tVals && tCount >= xCount;
+
+    if ((zVals && zCount > 1 && !zFull) || (tVals && tCount > 1 && !tFull) || (zFull && zStep < 1) || (tFull && tStep < 1))
+        return false;
+
+    if (!m_fastChecked)
+        EnsureFastPath();
+
+    if (!m_fast)
+        return false;
+
+    std::vector<int> missed;
+    if (forward)
+        fast_apply<true>(*m_fast, xVals, xStep, yVals, yStep, xCount, missed);
+    else
+        fast_apply<false>(*m_fast, xVals, xStep, yVals, yStep, xCount, missed);
+
+    if (missed.empty())
+        return true;
+
+    // Let PROJ handle the remaining coordinates in one call
+    int n = (int)missed.size();
+    std::vector<double> gx(n), gy(n), gz(zFull ? n : 0), gt(tFull ? n : 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        size_t j = missed[i];
+        gx[i] = xVals[j * xStep];
+        gy[i] = yVals[j * yStep];
+        if (zFull)
+            gz[i] = zVals[j * zStep];
+        if (tFull)
+            gt[i] = tVals[j * tStep];
+    }
+
+    proj_trans_generic(this, forward ? PJ_FWD : PJ_INV,
+        gx.data(), sizeof(double), n,
+        gy.data(), sizeof(double), n,
+        zFull ? gz.data() : zVals, (zFull ? 1 : zStep) * sizeof(double), zFull ? n : zCount,
+        tFull ? gt.data() : tVals, (tFull ? 1 : tStep) * sizeof(double), tFull ? n : tCount);
+
+    for (int i = 0; i < n; i++)
+    {
+        size_t j = missed[i];
+        xVals[j * xStep] = gx[i];
+        yVals[j * yStep] = gy[i];
+        if (zFull)
+            zVals[j * zStep] = gz[i];
+        if (tFull)
+            tVals[j * tStep] = gt[i];
+    }
+    return true;
+}
@@ -112,6 +112,19 @@ namespace SharpProj {
                 virtual void set(double value) { m_north = value; }
             }
 
+        public:
+            /// <summary>
+            /// Checks whether the position is inside this area. Areas crossing the antimeridian (<see cref="WestLongitude" /> greater
+            /// than <see cref="EastLongitude" />) and longitudes outside [-180, 180] are handled
+            /// </summary>
+            bool Contains(double longitude, double latitude);
+
+            /// <summary>
+            /// Checks for every position (longitudes[i], latitudes[i]) whether it is inside this area
+            /// </summary>
+            /// <returns>A bitmask with a bit set for every position inside the area</returns>
+            System::Collections::BitArray^ Contains(array<double>^ longitudes, array<double>^ latitudes);
+
         public:
             virtual String^ ToString() override
             {
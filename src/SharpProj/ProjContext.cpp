@@ -1,20 +1,130 @@
 #include "pch.h"
 
-#include <locale>
-#include <codecvt>
+#include <sqlite3.h>
 #include "ProjContext.h"
 #include "ProjException.h"
+#include "CoordinateReferenceSystem.h"
+#include "ProjContextPool.h"
 
 using namespace SharpProj;
 using namespace System::IO;
 using System::Collections::Generic::List;
 
+#pragma managed(push, off)
+// Number of bytes needed to encode the UTF-16 string as UTF-8, excluding the terminating 0
+static size_t utf8_length(const wchar_t* src, size_t len)
+{
+    size_t n = len;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        wchar_t c = src[i];
+
+        if (c < 0x80)
+            continue;
+        else if (c < 0x800)
+            n += 1;
+        else if (c >= 0xD800 && c <= 0xDBFF && i + 1 < len && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF)
+        {
+            n += 2; // 4 bytes for 2 chars
+            i++;
+        }
+        else
+            n += 2; // Including unpaired surrogates, which are written as U+FFFD
+    }
+    return n;
+}
+
+static char* utf8_encode(const wchar_t* src, size_t len, char* dest)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned c = src[i];
+
+        if (c < 0x80)
+        {
+            *dest++ = (char)c;
+            continue;
+        }
+        else if (c < 0x800)
+        {
+            *dest++ = (char)(0xC0 | (c >> 6));
+            *dest++ = (char)(0x80 | (c & 0x3F));
+            continue;
+        }
+        else if (c >= 0xD800 && c <= 0xDFFF)
+        {
+            if (c <= 0xDBFF && i + 1 < len && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF)
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + (src[++i] - 0xDC00);
+
+                *dest++ = (char)(0xF0 | (c >> 18));
+                *dest++ = (char)(0x80 | ((c >> 12) & 0x3F));
+                *dest++ = (char)(0x80 | ((c >> 6) & 0x3F));
+                *dest++ = (char)(0x80 | (c & 0x3F));
+                continue;
+            }
+            c = 0xFFFD;
+        }
+
+        *dest++ = (char)(0xE0 | (c >> 12));
+        *dest++ = (char)(0x80 | ((c >> 6) & 0x3F));
+        *dest++ = (char)(0x80 | (c & 0x3F));
+    }
+    return dest;
+}
+
+// Blocks of the per context string arena. Strings returned to PROJ from callbacks only have to live until the next
+// callback, so they are bump allocated and the whole arena is reset at once
+struct utf8_arena
+{
+    utf8_arena* next;
+    size_t used;
+    size_t size;
+    // Followed by size bytes of data
+
+    char* data()
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+static const size_t utf8_arena_block = 4096 - sizeof(utf8_arena);
+
+static char* utf8_arena_alloc(void*& chain, size_t n)
+{
+    utf8_arena* a = (utf8_arena*)chain;
+
+    if (!a || a->size - a->used < n)
+    {
+        size_t sz = (n > utf8_arena_block) ? n : utf8_arena_block;
+        utf8_arena* na = (utf8_arena*)malloc(sizeof(utf8_arena) + sz);
+
+        if (!na)
+            return nullptr;
+
+        na->next = a;
+        na->used = 0;
+        na->size = sz;
+        chain = a = na;
+    }
+
+    char* p = a->data() + a->used;
+    a->used += n;
+    return p;
+}
+#pragma managed(pop)
+
 std::string utf8_string(String^ v)
 {
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
-    pin_ptr<const wchar_t> pPath = PtrToStringChars(v);
-    std::wstring vstr(pPath);
-    std::string sstr(conv.to_bytes(vstr));
+    if (!v)
+        return std::string();
+
+    pin_ptr<const wchar_t> pStr = PtrToStringChars(v);
+    size_t len = v->Length;
+
+    std::string sstr(utf8_length(pStr, len), '\0');
+    utf8_encode(pStr, len, &sstr[0]);
     return sstr;
 }
 
@@ -33,25 +143,56 @@ const char* ProjContext::utf8_string(String^ value)
 
 const char* ProjContext::utf8_chain(String^ value, void*& chain)
 {
-    std::string v = ::utf8_string(value);
-    size_t slen = v.length() + 1;
-    void** pp = (void**)malloc(slen + sizeof(void*));
-    pp[0] = chain;
-    chain = pp;
-    return (char*)memcpy(&pp[1], v.c_str(), slen);
+    if (!value)
+        return nullptr;
+
+    pin_ptr<const wchar_t> pStr = PtrToStringChars(value);
+    size_t len = value->Length;
+
+    void* head = chain;
+    char* p = utf8_arena_alloc(chain, utf8_length(pStr, len) + 1);
+
+    if (!p)
+        throw gcnew OutOfMemoryException();
+    else if (chain != head)
+        System::Threading::Interlocked::Increment(_arenaAllocations);
+
+    *utf8_encode(pStr, len, p) = 0;
+    return p;
 }
 
 void ProjContext::free_chain(void*& chain)
 {
     while (chain)
     {
-        void* next = ((void**)chain)[0];
+        void* next = ((utf8_arena*)chain)->next;
         free(chain);
 
         chain = next;
     }
 }
 
+// Releases all strings in the arena, but keeps the last block for reuse
+void ProjContext::reset_chain(void*& chain)
+{
+    utf8_arena* a = (utf8_arena*)chain;
+
+    if (!a)
+        return;
+
+    void* older = a->next;
+    free_chain(older);
+
+    a->next = nullptr;
+    a->used = 0;
+
+    if (a->size > utf8_arena_block)
+    {
+        free(a); // Don't keep oversized blocks around
+        chain = nullptr;
+    }
+}
+
 static const char* my_file_finder(PJ_CONTEXT* ctx, const char* file, void* user_data)
 {
     UNUSED_ALWAYS(ctx);
@@ -93,16 +234,42 @@ static void my_log_func(void* user_data, int level, const char* message)
 
 
 ProjContext::ProjContext()
-    : ProjContext(proj_context_create())
+    : ProjContext(CreateContext())
 {
     if (EnableNetworkConnectionsOnNewContexts)
         EnableNetworkConnections = true; // Otherwise follow environment variable
+}
+
+// New contexts are cloned from a template that is configured once, instead of configuring every new context
+PJ_CONTEXT* ProjContext::CreateContext()
+{
+    PJ_CONTEXT* tmpl = (PJ_CONTEXT*)(void*)_ctxTemplate;
+
+    if (!tmpl)
+    {
+        tmpl = proj_context_create();
+        proj_log_level(tmpl, PJ_LOG_ERROR);
+        proj_context_use_proj4_init_rules(tmpl, false); // Ignore environment variable!
+
+        IntPtr prev = System::Threading::Interlocked::CompareExchange(_ctxTemplate, IntPtr(tmpl), IntPtr::Zero);
+
+        if (prev != IntPtr::Zero)
+        {
+            proj_context_destroy(tmpl);
+            tmpl = (PJ_CONTEXT*)(void*)prev;
+        }
+    }
 
-    LogLevel = ProjLogLevel::Error;
-    proj_context_use_proj4_init_rules(m_ctx, false); // Ignore environment variable!
+    return proj_context_clone(tmpl);
 }
 
 ProjContext::ProjContext(PJ_CONTEXT* ctx)
+    : ProjContext(ctx, true)
+{
+}
+
+// Without setupDatabase the shared database is not opened, so creating the context never searches or downloads proj.db
+ProjContext::ProjContext(PJ_CONTEXT* ctx, bool setupDatabase)
     : m_ctx(*new ctx_wrapper<PJ_CONTEXT, ProjContext>(ctx, proj_context_destroy))
 {
     if (!ctx)
@@ -114,7 +281,68 @@ ProjContext::ProjContext(PJ_CONTEXT* ctx)
     proj_log_func(m_ctx, &m_ctx, my_log_func);
     m_logLevel = (ProjLogLevel)proj_log_level(m_ctx, PJ_LOG_TELL);
 
-    SetupNetworkHandling();
+    // Otherwise installed when network connections are enabled
+    if (proj_context_is_network_enabled(m_ctx))
+        SetupNetworkHandling();
+
+    if (setupDatabase && _useSharedDatabase)
+        SetupSharedDatabase();
+}
+
+bool ProjContext::UseSharedDatabase::get()
+{
+    return _useSharedDatabase;
+}
+
+void ProjContext::UseSharedDatabase::set(bool value)
+{
+    if (value == _useSharedDatabase)
+        return;
+
+    if (value && !_sqliteConfigured)
+    {
+        // These are process wide settings, which SQLite only allows before it is initialized by opening the first database.
+        // Memory mapping is only a default for new connections, so this doesn't affect other users of SQLite.
+        const sqlite3_int64 mmap_size = 256 * 1024 * 1024;
+
+        if (sqlite3_config(SQLITE_CONFIG_URI, 1) != SQLITE_OK
+            || sqlite3_config(SQLITE_CONFIG_MMAP_SIZE, mmap_size, mmap_size) != SQLITE_OK)
+        {
+            throw gcnew InvalidOperationException("UseSharedDatabase must be enabled before proj.db is used for the first time");
+        }
+
+        // Still applied after disabling, and can't be applied again once a database is open
+        _sqliteConfigured = true;
+    }
+
+    _useSharedDatabase = value;
+}
+
+void ProjContext::SetupSharedDatabase()
+{
+    String^ uri = _sharedDatabaseUri;
+
+    if (!uri)
+    {
+        String^ path = FindFile("proj.db");
+
+        if (!path)
+            return; // PROJ will report the missing database when it is used
+
+        // 'immutable' tells SQLite the file never changes, so it doesn't have to lock or check for changes on each read
+        uri = (gcnew Uri(Path::GetFullPath(path)))->AbsoluteUri + "?immutable=1";
+        _sharedDatabaseUri = uri;
+    }
+
+    // PROJ shares the SQLite handle between all contexts that use the same database path
+    std::string dbPath = ::utf8_string(uri);
+
+    if (!proj_context_set_database_path(m_ctx, dbPath.c_str(), nullptr, nullptr))
+        ClearError();
+
+    // The catalog describes the database that was used before
+    m_catalog = nullptr;
+    m_catalogItems = nullptr;
 }
 
 ProjContext^ ProjContext::Clone()
@@ -130,12 +358,43 @@ SharpProj::ProjContext::~ProjContext()
     if (!m_disposed)
         EnableNetworkConnections = false;
 
+    DisposeIfNotNull(m_wgs84);
+    DisposeIfNotNull(m_batchPool);
     ProjContext::!ProjContext();
 }
 
+ProjContextPool^ ProjContext::BatchPool::get()
+{
+    if (!m_batchPool)
+        m_batchPool = gcnew ProjContextPool(this, true);
+
+    return m_batchPool;
+}
+
+CoordinateReferenceSystem^ ProjContext::Wgs84::get()
+{
+    if (!m_wgs84)
+    {
+        CoordinateReferenceSystem^ wgs84 = CoordinateReferenceSystem::CreateFromEpsg(4326, this);
+        try
+        {
+            m_wgs84 = wgs84->WithNormalizedAxis(nullptr);
+        }
+        finally
+        {
+            delete wgs84;
+        }
+    }
+
+    return m_wgs84;
+}
+
 ProjContext::!ProjContext()
 {
-    FlushChain();
+    void* chain = m_chain;
+    m_chain = nullptr;
+    free_chain(chain);
+
     if (m_disposed)
         return;
     m_disposed = true;
@@ -148,7 +407,7 @@ void SharpProj::ProjContext::FlushChain()
     void* chain = m_chain;
     try
     {
-        free_chain(chain);
+        reset_chain(chain);
     }
     finally
     {
@@ -348,6 +607,15 @@ System::Collections::Generic::IEnumerable<String^>^ ProjContext::ProjLibDirs::ge
     return static_cast<System::Collections::Generic::IEnumerable<String^>^>(_projLibDirs);
 }
 
+String^ ProjContext::UserWritableDirectory::get()
+{
+    // Only depends on the environment, so the same for all contexts
+    if (!_userWritableDir)
+        _userWritableDir = Utf8_PtrToString(proj_context_get_user_writable_directory(this, false));
+
+    return _userWritableDir;
+}
+
 // Update last write time when last write time more than one day old
 void ProjContext::TouchFile(String^ file)
 {
@@ -364,6 +632,53 @@ void ProjContext::TouchFile(String^ file)
 }
 
 String^ ProjContext::FindFile(String^ file)
+{
+    String^ found;
+
+    System::Threading::Monitor::Enter(_fileCache);
+    try
+    {
+        // No file system access on a hit. ClearFileCache() invalidates. A missing proj.db is
+        // remembered as well, but a context that may download it looks again
+        if (_fileCache->TryGetValue(file, found)
+            && (!String::IsNullOrEmpty(found) || file != "proj.db" || !EnableNetworkConnections))
+        {
+            return String::IsNullOrEmpty(found) ? nullptr : found;
+        }
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(_fileCache);
+    }
+
+    found = ResolveFile(file);
+
+    System::Threading::Monitor::Enter(_fileCache);
+    try
+    {
+        _fileCache[file] = found ? found : String::Empty;
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(_fileCache);
+    }
+    return found;
+}
+
+void ProjContext::ClearFileCache()
+{
+    System::Threading::Monitor::Enter(_fileCache);
+    try
+    {
+        _fileCache->Clear();
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(_fileCache);
+    }
+}
+
+String^ ProjContext::ResolveFile(String^ file)
 {
     String^ testFile;
 
@@ -373,8 +688,7 @@ String^ ProjContext::FindFile(String^ file)
             return testFile;
     }
 
-    const char* pUserDir = proj_context_get_user_writable_directory(this, false);
-    String^ userDir = Utf8_PtrToString(pUserDir);
+    String^ userDir = UserWritableDirectory;
 
 
     // UserDir is already contained in ProjLibDirs, so need to probe for the normal name here
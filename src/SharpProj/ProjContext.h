@@ -12,12 +12,15 @@ using namespace System;
 namespace SharpProj {
     ref class ProjException;
     ref class CoordinateReferenceSystem;
+    ref class CoordinateArea;
+    ref class ProjContextPool;
 
     namespace Proj {
         ref class ProjObject;
         ref class CoordinateReferenceSystemFilter;
         ref class CoordinateReferenceSystemInfo;
         ref class CelestialBodyInfo;
+        ref class CoordinateReferenceSystemCatalog;
     }
 
     public enum class ProjLogLevel
@@ -168,24 +171,67 @@ namespace SharpProj {
         String^ m_lastError;
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         ProjLogLevel m_logLevel;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        Proj::CoordinateReferenceSystemCatalog^ m_catalog;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        array<Proj::CoordinateReferenceSystemInfo^>^ m_catalogItems;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        String^ m_catalogDatabase;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        CoordinateReferenceSystem^ m_wgs84;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        ProjContextPool^ m_batchPool;
 
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         static array<String^>^ _projLibDirs;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static String^ _userWritableDir;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static initonly System::Collections::Generic::Dictionary<String^, String^>^ _fileCache
+            = gcnew System::Collections::Generic::Dictionary<String^, String^>(StringComparer::Ordinal);
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static IntPtr _ctxTemplate;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static __int64 _arenaAllocations;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static bool _useSharedDatabase;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static bool _sqliteConfigured;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        static String^ _sharedDatabaseUri;
 
         [DebuggerBrowsable(DebuggerBrowsableState::Never)]
         bool m_disposed;
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        bool m_networkSetup;
         ProjContext(PJ_CONTEXT* ctx);
+        ProjContext(PJ_CONTEXT* ctx, bool setupDatabase);
+        static PJ_CONTEXT* CreateContext();
         void SetupNetworkHandling();
+        void SetupSharedDatabase();
 
     public:
         static initonly String^ DefaultEndpointUrl = "https://cdn.proj.org";
         static property bool EnableNetworkConnectionsOnNewContexts;
 
+        /// <summary>
+        /// Gets or sets a boolean indicating whether new contexts open proj.db as an immutable, memory mapped database.
+        /// All contexts then share a single database connection and the operating system shares the mapped pages between
+        /// processes. Enabling must happen before the database is used for the first time.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">Enabled after the database was already used</exception>
+        static property bool UseSharedDatabase
+        {
+            bool get();
+            void set(bool value);
+        }
+
     internal:
         const char* utf8_string(String^ value);
 
         const char* utf8_chain(String^ value, void*& chain);
         void free_chain(void*& chain);
+        void reset_chain(void*& chain);
         void FlushChain();
 
     public:
@@ -216,6 +262,9 @@ namespace SharpProj {
             }
             void set(bool value)
             {
+                if (value && !m_networkSetup)
+                    SetupNetworkHandling();
+
                 proj_context_set_enable_network(this, value);
 
                 if (value)
@@ -291,10 +340,16 @@ namespace SharpProj {
         {
             System::Collections::Generic::IEnumerable<String^>^ get();
         }
+        [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+        property String^ UserWritableDirectory
+        {
+            String^ get();
+        }
         void TouchFile(String^ file);
 
     internal:
         String^ FindFile(String^ file);
+        String^ ResolveFile(String^ file);
         void OnLogMessage(ProjLogLevel level, String^ message);
 
     public:
@@ -424,14 +479,100 @@ namespace SharpProj {
         System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ GetCoordinateReferenceSystems(CoordinateReferenceSystemFilter^ filter);
         System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ GetCoordinateReferenceSystems();
 
+        /// <summary>
+        /// Gets the <see cref="CoordinateReferenceSystem"/>s of which the area of use contains the location, ordered by the size
+        /// of their area of use (most specific first)
+        /// </summary>
+        /// <param name="longitude">Longitude in degrees</param>
+        /// <param name="latitude">Latitude in degrees</param>
+        /// <param name="filter">Optional additional conditions. The area in the filter is ignored</param>
+        /// <returns></returns>
+        System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ FindCoordinateReferenceSystems(double longitude, double latitude, [Optional] CoordinateReferenceSystemFilter^ filter);
+        /// <summary>
+        /// Gets the <see cref="CoordinateReferenceSystem"/>s of which the area of use contains the area, ordered by the size
+        /// of their area of use (most specific first)
+        /// </summary>
+        /// <param name="area">Area to cover. May cross the antimeridian</param>
+        /// <param name="filter">Optional additional conditions. The area in the filter is ignored</param>
+        /// <returns></returns>
+        System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ FindCoordinateReferenceSystems(CoordinateArea^ area, [Optional] CoordinateReferenceSystemFilter^ filter);
+
+        /// <summary>
+        /// Searches the <see cref="CoordinateReferenceSystem"/>s of which the name, area name or projection name contain all
+        /// words in the text (case and diacritics insensitive). Whole words and prefixes rank above other matches and matches in
+        /// the name above matches in the other names.
+        /// </summary>
+        /// <param name="text">Text to search for, like 'amersfoort rd'</param>
+        /// <returns></returns>
+        System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ SearchCoordinateReferenceSystems(String^ text);
+        /// <summary>
+        /// Searches the <see cref="CoordinateReferenceSystem"/>s of which the name, area name or projection name contain all
+        /// words in the text (case and diacritics insensitive), most relevant first.
+        /// </summary>
+        /// <param name="text">Text to search for, like 'amersfoort rd'</param>
+        /// <param name="maxResults">Maximum number of results to return</param>
+        /// <param name="filter">Optional additional conditions. By default deprecated coordinate reference systems are skipped</param>
+        /// <returns></returns>
+        System::Collections::ObjectModel::ReadOnlyCollection<CoordinateReferenceSystemInfo^>^ SearchCoordinateReferenceSystems(String^ text, int maxResults, [Optional] CoordinateReferenceSystemFilter^ filter);
+
         System::Collections::ObjectModel::ReadOnlyCollection<CelestialBodyInfo^>^ GetCelestialBodies();
 
+    internal:
+        property Proj::CoordinateReferenceSystemCatalog^ Catalog
+        {
+            Proj::CoordinateReferenceSystemCatalog^ get();
+        }
+
+        /// <summary>
+        /// Clones of this context for batch operations that clone a PJ per worker, reused between calls
+        /// </summary>
+        property ProjContextPool^ BatchPool
+        {
+            ProjContextPool^ get();
+        }
+        Proj::CoordinateReferenceSystemInfo^ GetCatalogItem(int index);
+
+        /// <summary>
+        /// WGS84 with normalized (lon, lat) axis order, shared by all usage areas on this context
+        /// </summary>
+        property CoordinateReferenceSystem^ Wgs84
+        {
+            CoordinateReferenceSystem^ get();
+        }
+
     protected:
         virtual void OnLog(ProjLogLevel level, String^ message)
         {
             Log(level, message);
         }
 
+    public:
+        /// <summary>
+        /// Makes sure proj.db is available, by downloading the matching SharpProj.Database package to the user writable
+        /// directory in the background when no local copy can be found. Contexts that need the database while this is
+        /// running wait for the same download. Partial downloads are resumed on a later attempt.
+        /// </summary>
+        /// <returns>A task that completes with true when proj.db is available</returns>
+        static System::Threading::Tasks::Task<bool>^ PrepareProjDBAsync();
+
+        /// <summary>
+        /// Gets the number of native blocks allocated for strings passed back to PROJ from callbacks, over all contexts
+        /// </summary>
+        [EditorBrowsable(EditorBrowsableState::Advanced)]
+        static property __int64 StringArenaAllocations
+        {
+            __int64 get()
+            {
+                return System::Threading::Interlocked::Read(_arenaAllocations);
+            }
+        }
+
+        /// <summary>
+        /// Forgets where the support files (grids, init files, proj.db, ...) requested by PROJ were found. Lookups are
+        /// remembered for the whole process, so call this after adding or removing files in the search locations.
+        /// </summary>
+        static void ClearFileCache();
+
     internal:
         static void DownloadProjDB(String^ toPath);
         static operator PJ_CONTEXT* (ProjContext^ me)
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace SharpProj {
+    /// <summary>
+    /// Hands out clones of a context to the workers of a parallel loop, as a context may only be used by one thread at
+    /// a time. The clones stay alive until the pool is disposed, so objects created in them can still be moved to
+    /// another context after the loop. A reusing pool hands out returned clones again, for loops that destroy
+    /// everything they create in the clones.
+    /// </summary>
+    private ref class ProjContextPool sealed
+    {
+    private:
+        initonly ProjContext^ m_ctx;
+        initonly System::Collections::Generic::List<ProjContext^>^ m_clones;
+        initonly System::Collections::Generic::Stack<ProjContext^>^ m_idle;
+
+    public:
+        ProjContextPool(ProjContext^ ctx)
+        {
+            if (!ctx)
+                throw gcnew ArgumentNullException("ctx");
+
+            m_ctx = ctx;
+            m_clones = gcnew System::Collections::Generic::List<ProjContext^>();
+        }
+
+        ProjContextPool(ProjContext^ ctx, bool reuse)
+        {
+            if (!ctx)
+                throw gcnew ArgumentNullException("ctx");
+
+            m_ctx = ctx;
+            m_clones = gcnew System::Collections::Generic::List<ProjContext^>();
+            if (reuse)
+                m_idle = gcnew System::Collections::Generic::Stack<ProjContext^>();
+        }
+
+        ~ProjContextPool()
+        {
+            System::Threading::Monitor::Enter(m_clones);
+            try
+            {
+                for each (ProjContext ^ pc in m_clones)
+                    delete pc;
+
+                m_clones->Clear();
+                if (m_idle)
+                    m_idle->Clear();
+            }
+            finally
+            {
+                System::Threading::Monitor::Exit(m_clones);
+            }
+        }
+
+        ProjContext^ Rent()
+        {
+            // Cloning reads the original context, so don't do that from multiple threads at once
+            System::Threading::Monitor::Enter(m_clones);
+            try
+            {
+                if (m_idle && m_idle->Count)
+                    return m_idle->Pop();
+
+                ProjContext^ pc = m_ctx->Clone();
+
+                m_clones->Add(pc);
+                return pc;
+            }
+            finally
+            {
+                System::Threading::Monitor::Exit(m_clones);
+            }
+        }
+
+        void Return(ProjContext^ ctx)
+        {
+            if (!m_idle)
+                return; // Kept until the pool is disposed
+
+            System::Threading::Monitor::Enter(m_clones);
+            try
+            {
+                m_idle->Push(ctx);
+            }
+            finally
+            {
+                System::Threading::Monitor::Exit(m_clones);
+            }
+        }
+    };
+}
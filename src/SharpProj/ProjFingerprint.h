@@ -0,0 +1,75 @@
+#pragma once
+
+namespace SharpProj {
+    namespace Proj {
+
+        /// <summary>
+        /// 128 bit structural fingerprint of a <see cref="ProjObject"/>, calculated from its PROJJSON definition without
+        /// identifiers, usages and remarks. Objects with the same fingerprint have the same definition, so it can be used
+        /// as dictionary key to find equivalent objects without pairwise <see cref="ProjObject::IsEquivalentTo"/> calls.
+        /// Objects that only differ in naming or axis order have different fingerprints.
+        /// </summary>
+        /// <remarks>The fingerprint is only stable within a single PROJ version</remarks>
+        [DebuggerDisplay("{ToString(),nq}")]
+        public value class ProjFingerprint : IEquatable<ProjFingerprint>
+        {
+        private:
+            initonly UInt64 m_high;
+            initonly UInt64 m_low;
+
+        public:
+            ProjFingerprint(UInt64 high, UInt64 low)
+            {
+                m_high = high;
+                m_low = low;
+            }
+
+            property UInt64 High
+            {
+                UInt64 get() { return m_high; }
+            }
+
+            property UInt64 Low
+            {
+                UInt64 get() { return m_low; }
+            }
+
+            property bool IsEmpty
+            {
+                bool get() { return !m_high && !m_low; }
+            }
+
+            virtual bool Equals(ProjFingerprint other) sealed
+            {
+                return m_high == other.m_high && m_low == other.m_low;
+            }
+
+            virtual bool Equals(Object^ other) override sealed
+            {
+                ProjFingerprint^ o = dynamic_cast<ProjFingerprint^>(other);
+
+                return o && Equals(*o);
+            }
+
+            virtual int GetHashCode() override sealed
+            {
+                return (int)m_low ^ (int)(m_low >> 32);
+            }
+
+            virtual String^ ToString() override
+            {
+                return m_high.ToString("x16") + m_low.ToString("x16");
+            }
+
+            static bool operator ==(ProjFingerprint a, ProjFingerprint b)
+            {
+                return a.Equals(b);
+            }
+
+            static bool operator !=(ProjFingerprint a, ProjFingerprint b)
+            {
+                return !a.Equals(b);
+            }
+        };
+    }
+}
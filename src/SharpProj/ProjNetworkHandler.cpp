@@ -331,6 +331,7 @@ size_t my_network_read_range(
 
 void ProjContext::SetupNetworkHandling()
 {
+    m_networkSetup = true;
     proj_context_set_network_callbacks(
         m_ctx,
         my_network_open,
@@ -340,53 +341,303 @@ void ProjContext::SetupNetworkHandling()
         &m_ctx);
 }
 
-void ProjContext::DownloadProjDB(String^ target)
+// Downloads the SharpProj.Database package into a '.part' file next to the target. The partial file is
+// kept exclusively open while downloading, so other processes wait for us instead of racing on it, and
+// it is left behind on network errors to allow resuming via a HTTP range request on the next attempt.
+private ref class ProjDBDownload sealed
 {
-    using namespace System::IO::Compression;
-    WebResponse^ rp = nullptr;
-    try
+private:
+    initonly String^ m_target;
+    static initonly Object^ s_lock = gcnew Object();
+    static initonly System::Collections::Generic::Dictionary<String^, System::Threading::Tasks::Task<bool>^>^ s_running
+        = gcnew System::Collections::Generic::Dictionary<String^, System::Threading::Tasks::Task<bool>^>(StringComparer::OrdinalIgnoreCase);
+
+    literal String^ PackageUrl = "https://api.nuget.org/v3-flatcontainer/sharpproj.database/" PROJ_VERSION "/sharpproj.database." PROJ_VERSION ".nupkg";
+    literal String^ PackageInfoUrl = "https://www.nuget.org/api/v2/Packages(Id='SharpProj.Database',Version='" PROJ_VERSION "')";
+    literal int LockWaitSeconds = 300;
+
+    ProjDBDownload(String^ target)
+    {
+        m_target = target;
+    }
+
+public:
+    static System::Threading::Tasks::Task<bool>^ Start(String^ target)
     {
-        WebRequest^ wr = WebRequest::Create("https://www.nuget.org/api/v2/package/SharpProj.Database/" PROJ_VERSION);
-        rp = wr->GetResponse();
-        Stream^ stream = rp->GetResponseStream();
-        Stream^ sz = nullptr;
-        Stream^ tmp = nullptr;
+        using System::Threading::Tasks::Task;
+        System::Threading::Monitor::Enter(s_lock);
         try
         {
-            auto za = gcnew System::IO::Compression::ZipArchive(stream, ZipArchiveMode::Read);
+            Task<bool>^ t;
 
-            sz = za->GetEntry("contentFiles/any/any/proj.db")->Open();
-            tmp = File::Create(target + ".tmp");
+            // Share a running (or succeeded) download. Start a new attempt after a failure
+            if (s_running->TryGetValue(target, t) && !(t->IsCompleted && !t->Result))
+                return t;
 
-            sz->CopyTo(tmp);
-            tmp->Close();
-            tmp = nullptr;
-            delete sz;
-            sz = nullptr;
+            t = Task::Run<bool>(gcnew Func<bool>(gcnew ProjDBDownload(target), &ProjDBDownload::Run));
+            s_running[target] = t;
+            return t;
+        }
+        finally
+        {
+            System::Threading::Monitor::Exit(s_lock);
+        }
+    }
+
+private:
+    bool Run()
+    {
+        if (!Download())
+            return false;
 
-            File::Move(target + ".tmp", target);
+        // Contexts may have remembered that proj.db was missing
+        ProjContext::ClearFileCache();
+        return true;
+    }
+
+    bool Download()
+    {
+        if (File::Exists(m_target))
+            return true;
+
+        String^ part = m_target + ".part";
+        FileStream^ fs = nullptr;
+
+        for (int i = 0; !fs; i++)
+        {
+            try
+            {
+                fs = gcnew FileStream(part, FileMode::OpenOrCreate, FileAccess::ReadWrite, FileShare::None);
+            }
+            catch (IOException^)
+            {
+                // Most likely another process is downloading. Wait for it to complete
+                if (File::Exists(m_target))
+                    return true;
+                else if (i >= LockWaitSeconds)
+                    return false;
+
+                System::Threading::Thread::Sleep(1000);
+            }
+            catch (UnauthorizedAccessException^)
+            {
+                return false;
+            }
         }
-        catch (Exception^)
+
+        try
         {
-            if (tmp)
-                delete tmp;
-            if (sz)
-                delete sz;
-            if (stream)
-                delete stream;
+            if (File::Exists(m_target))
+                return true; // Completed by another process while we were waiting
+
+            if (!DownloadPackage(fs))
+                return false;
+
+            String^ expectedHash = FetchPackageHash();
+
+            if (expectedHash)
+            {
+                fs->Position = 0;
+                auto sha = System::Security::Cryptography::SHA512::Create();
+                String^ hash;
+                try
+                {
+                    hash = Convert::ToBase64String(sha->ComputeHash(fs));
+                }
+                finally
+                {
+                    delete sha;
+                }
+
+                if (hash != expectedHash)
+                {
+                    fs->SetLength(0); // Corrupt. Don't try to resume from this
+                    return false;
+                }
+            }
+
+            fs->Position = 0;
+            if (!ExtractDatabase(fs))
+            {
+                fs->SetLength(0);
+                return false;
+            }
+
+            delete fs;
+            fs = nullptr;
 
             try
             {
-                File::Delete(target + ".tmp");
+                File::Delete(part);
             }
-            catch (Exception^)
+            catch (IOException^)
             {
             }
+
+            return true;
+        }
+        catch (Exception^)
+        {
+            return false;
+        }
+        finally
+        {
+            if (fs)
+                delete fs;
         }
     }
-    catch (Exception^)
+
+    static bool DownloadPackage(FileStream^ fs)
     {
-        if (rp)
+        long long have = fs->Length;
+
+        HttpWebRequest^ rq = safe_cast<HttpWebRequest^>(WebRequest::Create(PackageUrl));
+        rq->UserAgent = "System.Net/SharpProj using PROJ " PROJ_VERSION;
+
+        if (have > 0)
+            rq->AddRange(have);
+
+        HttpWebResponse^ rp;
+        try
+        {
+            rp = safe_cast<HttpWebResponse^>(rq->GetResponse());
+        }
+        catch (System::Net::WebException^ wx)
+        {
+            HttpWebResponse^ hrp = dynamic_cast<HttpWebResponse^>(wx->Response);
+
+            // Range starting at the end of the file: we already have everything
+            bool complete = (have > 0 && hrp && (int)hrp->StatusCode == 416 /* RequestedRangeNotSatisfiable */);
+
+            if (hrp)
+                delete hrp;
+
+            return complete;
+        }
+
+        try
+        {
+            if (rp->StatusCode == HttpStatusCode::PartialContent)
+                fs->Seek(0, SeekOrigin::End);
+            else if (rp->StatusCode == HttpStatusCode::OK)
+                fs->SetLength(0); // Range not honored. Restart
+            else
+                return false;
+
+            Stream^ s = rp->GetResponseStream();
+            s->CopyTo(fs);
+            fs->Flush();
+            return true;
+        }
+        finally
+        {
             delete rp;
+        }
+    }
+
+    // Returns the base64 encoded SHA512 hash of the package as published by NuGet, or nullptr if unavailable
+    static String^ FetchPackageHash()
+    {
+        try
+        {
+            WebResponse^ rp = WebRequest::Create(PackageInfoUrl)->GetResponse();
+            try
+            {
+                System::Xml::XmlDocument^ doc = gcnew System::Xml::XmlDocument();
+                doc->Load(rp->GetResponseStream());
+
+                String^ ns = "http://schemas.microsoft.com/ado/2007/08/dataservices";
+                auto algorithm = doc->GetElementsByTagName("PackageHashAlgorithm", ns);
+                auto hash = doc->GetElementsByTagName("PackageHash", ns);
+
+                if (hash->Count == 1 && algorithm->Count == 1 && algorithm[0]->InnerText == "SHA512")
+                    return hash[0]->InnerText;
+            }
+            finally
+            {
+                delete rp;
+            }
+        }
+        catch (Exception^)
+        {
+        }
+        return nullptr;
+    }
+
+    bool ExtractDatabase(Stream^ package)
+    {
+        using namespace System::IO::Compression;
+        String^ tmp = m_target + ".tmp";
+
+        ZipArchive za(package, ZipArchiveMode::Read, true);
+        auto entry = za.GetEntry("contentFiles/any/any/proj.db");
+
+        if (!entry)
+            return false;
+
+        Stream^ sz = entry->Open();
+        try
+        {
+            FileStream^ t = File::Create(tmp);
+            try
+            {
+                sz->CopyTo(t);
+
+                // Verify that we have a SQLite database before making it available
+                static const char sqlite_header[] = "SQLite format 3"; // Including '\0'
+                array<Byte>^ header = gcnew array<Byte>(sizeof(sqlite_header));
+                t->Position = 0;
+                bool valid = (t->Read(header, 0, header->Length) == header->Length);
+
+                for (int i = 0; valid && i < header->Length; i++)
+                    valid = (header[i] == (Byte)sqlite_header[i]);
+
+                if (!valid)
+                {
+                    delete t;
+                    t = nullptr;
+                    File::Delete(tmp);
+                    return false;
+                }
+            }
+            finally
+            {
+                if (t)
+                    delete t;
+            }
+        }
+        finally
+        {
+            delete sz;
+        }
+
+        File::Move(tmp, m_target);
+        return true;
+    }
+};
+
+void ProjContext::DownloadProjDB(String^ target)
+{
+    ProjDBDownload::Start(target)->Wait();
+}
+
+System::Threading::Tasks::Task<bool>^ ProjContext::PrepareProjDBAsync()
+{
+    // A plain new context could already search for, and download, proj.db to set up the shared database
+    ProjContext^ pc = gcnew ProjContext(CreateContext(), false);
+    try
+    {
+        pc->EnableNetworkConnections = false; // Only probe for local copies
+
+        if (pc->FindFile("proj.db"))
+            return System::Threading::Tasks::Task::FromResult(true);
+
+        String^ userDir = Utf8_PtrToString(proj_context_get_user_writable_directory(pc, true));
+
+        return ProjDBDownload::Start(Path::Combine(userDir, ("#proj" "-" PROJ_VERSION "-") + "proj.db"));
+    }
+    finally
+    {
+        delete pc;
     }
 }
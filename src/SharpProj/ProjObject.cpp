@@ -1,4 +1,5 @@
 #include "pch.h"
+#include <cstdint>
 #include "ProjObject.h"
 #include "ProjException.h"
 #include "PPoint.h"
@@ -39,6 +40,454 @@ ProjObject::~ProjObject()
     ProjObject::!ProjObject();
 }
 
+#pragma managed(push, off)
+namespace {
+    struct fingerprint_hasher
+    {
+        uint64_t h1 = 0xcbf29ce484222325ULL; // FNV-1a 64 offset basis
+        uint64_t h2 = 0x6a09e667f3bcc908ULL;
+        uint64_t len = 0;
+
+        void add(char c)
+        {
+            h1 = (h1 ^ (unsigned char)c) * 0x100000001b3ULL;
+            h2 = (h2 ^ (unsigned char)c) * 0x9e3779b97f4a7c15ULL;
+            h2 = (h2 << 23) | (h2 >> 41);
+            len++;
+        }
+
+        void add(const char* from, const char* to)
+        {
+            while (from < to)
+                add(*from++);
+        }
+
+        static uint64_t mix(uint64_t z)
+        {
+            // splitmix64 finalizer
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        void finish(uint64_t& high, uint64_t& low) const
+        {
+            low = mix(h1 ^ len);
+            high = mix(h2 + low);
+
+            if (!high && !low)
+                low = 1; // Empty is reserved for 'not calculated'
+        }
+    };
+
+    static inline bool is_json_space(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // p points to the opening quote. Returns the position after the closing quote
+    static const char* skip_json_string(const char* p)
+    {
+        for (p++; *p && *p != '"'; p++)
+        {
+            if (*p == '\\' && p[1])
+                p++;
+        }
+        return *p ? p + 1 : p;
+    }
+
+    static const char* skip_json_value(const char* p)
+    {
+        if (*p == '"')
+            return skip_json_string(p);
+        else if (*p == '{' || *p == '[')
+        {
+            int depth = 0;
+            while (*p)
+            {
+                if (*p == '"')
+                {
+                    p = skip_json_string(p);
+                    continue;
+                }
+                else if (*p == '{' || *p == '[')
+                    depth++;
+                else if ((*p == '}' || *p == ']') && !--depth)
+                    return p + 1;
+                p++;
+            }
+            return p;
+        }
+
+        while (*p && *p != ',' && *p != '}' && *p != ']')
+            p++;
+        return p;
+    }
+
+    // Members that describe where and how an object is used, instead of what it is
+    static bool is_metadata_member(const char* name, size_t len)
+    {
+        static const char* const ignored[] = { "$schema", "id", "ids", "usages", "scope", "area", "bbox", "remarks", "vertical_extent", "temporal_extent" };
+
+        for (const char* i : ignored)
+        {
+            if (strlen(i) == len && !memcmp(i, name, len))
+                return true;
+        }
+        return false;
+    }
+
+    // Hashes the PROJJSON text without whitespace and metadata members
+    static void hash_projjson(const char* p, fingerprint_hasher& h)
+    {
+        bool pendingComma = false;
+        char last = 0;
+
+        while (*p)
+        {
+            char c = *p;
+
+            if (is_json_space(c))
+            {
+                p++;
+                continue;
+            }
+            else if (c == ',')
+            {
+                pendingComma = true;
+                p++;
+                continue;
+            }
+            else if (c == '}' || c == ']')
+            {
+                pendingComma = false;
+                h.add(last = c);
+                p++;
+                continue;
+            }
+
+            const char* end = (c == '"') ? skip_json_string(p) : p + 1;
+
+            if (c == '"')
+            {
+                const char* q = end;
+                while (is_json_space(*q))
+                    q++;
+
+                if (*q == ':' && is_metadata_member(p + 1, (end - p) - 2))
+                {
+                    for (q++; is_json_space(*q); q++)
+                    {
+                    }
+                    p = skip_json_value(q);
+                    continue;
+                }
+            }
+
+            if (pendingComma && last != '{' && last != '[')
+                h.add(',');
+            pendingComma = false;
+
+            h.add(p, end);
+            last = end[-1];
+            p = end;
+        }
+    }
+}
+#pragma managed(pop)
+
+ProjFingerprint ProjObject::Fingerprint::get()
+{
+    if (m_fingerprint.IsEmpty)
+    {
+        fingerprint_hasher h;
+        const char* opts[] = { "MULTILINE=NO", nullptr };
+        const char* json = m_noProj ? nullptr : proj_as_projjson(Context, this, opts);
+
+        if (json)
+        {
+            h.add('J');
+            hash_projjson(json, h);
+        }
+        else
+        {
+            // Not every object (e.g. some PROJ string based operations) can be exported as PROJJSON
+            Context->ClearError(this);
+            const char* def = m_noProj ? nullptr : proj_as_proj_string(Context, this, PJ_PROJ_5, nullptr);
+
+            if (def)
+                h.add('P');
+            else
+            {
+                Context->ClearError(this);
+                def = proj_pj_info(this).definition;
+                h.add('D');
+            }
+
+            if (def)
+                h.add(def, def + strlen(def));
+        }
+
+        uint64_t high, low;
+        h.finish(high, low);
+        m_fingerprint = ProjFingerprint(high, low);
+    }
+    return m_fingerprint;
+}
+
+// Export cache keys: bits 0-1 the export kind, bits 2-9 the output type and bits 10+ the option flags
+enum
+{
+    EXPORT_WKT = 1,
+    EXPORT_PROJJSON = 2,
+    EXPORT_PROJSTRING = 3,
+
+    EXPORT_FLAG1 = 1 << 10,
+    EXPORT_FLAG2 = 1 << 11,
+    EXPORT_FLAG3 = 1 << 12,
+    EXPORT_FLAG4 = 1 << 13,
+    EXPORT_FLAG5 = 1 << 14,
+    EXPORT_FLAG6 = 1 << 15
+};
+
+static int wkt_key(WktOptions^ options)
+{
+    PJ_WKT_TYPE tp = options ? (PJ_WKT_TYPE)options->WktType : PJ_WKT2_2019;
+    int key = EXPORT_WKT | ((int)tp << 2);
+
+    if (options && (tp != PJ_WKT1_ESRI) == options->SingleLine)
+        key |= EXPORT_FLAG1;
+    if (options && options->NoIndentation)
+        key |= EXPORT_FLAG2;
+    if (options && options->WriteAxis.HasValue)
+        key |= options->WriteAxis.Value ? (EXPORT_FLAG3 | EXPORT_FLAG4) : EXPORT_FLAG3;
+    if (!options || !options->Strict)
+        key |= EXPORT_FLAG5;
+    if (options && options->AllowEllipsoidalHeightAsVerticalCRS)
+        key |= EXPORT_FLAG6;
+
+    return key;
+}
+
+static int projjson_key(ProjJsonOptions^ options)
+{
+    int key = EXPORT_PROJJSON;
+
+    if (options)
+    {
+        switch (options->ProjJsonType)
+        {
+        case ProjJsonType::None:
+        case ProjJsonType::SchemaV02:
+        case ProjJsonType::SchemaV04:
+            key |= (int)options->ProjJsonType << 2;
+            break;
+        default:
+            throw gcnew ArgumentOutOfRangeException();
+        }
+
+        if (options->NoMultiLine)
+            key |= EXPORT_FLAG1;
+        if (options->NoIndentation)
+            key |= EXPORT_FLAG2;
+    }
+    return key;
+}
+
+static int projstring_key(ProjStringOptions^ options)
+{
+    PJ_PROJ_STRING_TYPE string_type = options ? (PJ_PROJ_STRING_TYPE)options->ProjStringType : PJ_PROJ_5 /* Last as of 2021-01 */;
+    int key = EXPORT_PROJSTRING | ((int)string_type << 2);
+
+    if (options && options->MultiLine)
+        key |= EXPORT_FLAG1;
+    if (options && options->NoIndentation)
+        key |= EXPORT_FLAG2;
+    if (options && options->WriteApproxFlag)
+        key |= EXPORT_FLAG3;
+
+    return key;
+}
+
+static const char* export_native(PJ_CONTEXT* ctx, PJ* pj, int key)
+{
+    const char* opts[30] = {};
+    int nOpts = 0;
+    int tp = (key >> 2) & 0xFF;
+
+    switch (key & 3)
+    {
+    case EXPORT_WKT:
+        if (key & EXPORT_FLAG1)
+            opts[nOpts++] = (tp != PJ_WKT1_ESRI) ? "MULTILINE=NO" : "MULTILINE=YES";
+        if (key & EXPORT_FLAG2)
+            opts[nOpts++] = "INDENTATION_WIDTH=0";
+        if (key & EXPORT_FLAG3)
+            opts[nOpts++] = (key & EXPORT_FLAG4) ? "OUTPUT_AXIS=YES" : "OUTPUT_AXIS=NO";
+        if (key & EXPORT_FLAG5)
+            opts[nOpts++] = "STRICT=NO";
+        if (key & EXPORT_FLAG6)
+            opts[nOpts++] = "ALLOW_ELLIPSOIDAL_HEIGHT_AS_VERTICAL_CRS=YES";
+
+        return proj_as_wkt(ctx, pj, (PJ_WKT_TYPE)tp, opts);
+
+    case EXPORT_PROJJSON:
+        if (key & EXPORT_FLAG1)
+            opts[nOpts++] = "MULTILINE=NO";
+        if (key & EXPORT_FLAG2)
+            opts[nOpts++] = "INDENTATION_WIDTH=0";
+        if (tp == (int)ProjJsonType::SchemaV02)
+            opts[nOpts++] = "SCHEMA=https://proj.org/schemas/v0.2/projjson.schema.json";
+        else if (tp == (int)ProjJsonType::SchemaV04)
+            opts[nOpts++] = "SCHEMA=https://proj.org/schemas/v0.4/projjson.schema.json";
+
+        return proj_as_projjson(ctx, pj, opts);
+
+    case EXPORT_PROJSTRING:
+        if (key & EXPORT_FLAG1)
+            opts[nOpts++] = "MULTILINE=YES";
+        if (key & EXPORT_FLAG2)
+            opts[nOpts++] = "INDENTATION_WIDTH=0";
+        if (key & EXPORT_FLAG3)
+            opts[nOpts++] = "USE_APPROX_TMERC=YES";
+
+        return proj_as_proj_string(ctx, pj, (PJ_PROJ_STRING_TYPE)tp, opts);
+    }
+    return nullptr;
+}
+
+ProjObject::ExportEntry^ ProjObject::Export(int key)
+{
+    if (m_noProj)
+        return nullptr;
+
+    if (!m_exports)
+    {
+        typedef System::Collections::Generic::Dictionary<int, ExportEntry^> ExportDictionary;
+        System::Threading::Interlocked::CompareExchange<ExportDictionary^>(m_exports, gcnew ExportDictionary(), nullptr);
+    }
+
+    ExportEntry^ entry;
+    System::Threading::Monitor::Enter(m_exports);
+    try
+    {
+        if (m_exports->TryGetValue(key, entry))
+            return entry;
+
+        // The result is only valid until the next export call on this object, so copy it while holding the lock
+        const char* v = export_native(Context, this, key);
+
+        if (!v)
+            return nullptr;
+
+        int len = (int)strlen(v);
+        entry = gcnew ExportEntry();
+        entry->Utf8 = gcnew array<Byte>(len);
+        if (len)
+            System::Runtime::InteropServices::Marshal::Copy(IntPtr(const_cast<char*>(v)), entry->Utf8, 0, len);
+
+        m_exports->Add(key, entry);
+        return entry;
+    }
+    finally
+    {
+        System::Threading::Monitor::Exit(m_exports);
+    }
+}
+
+String^ ProjObject::ExportText(int key)
+{
+    ExportEntry^ entry = Export(key);
+
+    if (!entry)
+        return nullptr;
+
+    String^ text = entry->Text;
+    if (!text)
+        entry->Text = text = System::Text::Encoding::UTF8->GetString(entry->Utf8);
+
+    return text;
+}
+
+void ProjObject::ExportWrite(int key, System::IO::Stream^ stream)
+{
+    if (!stream)
+        throw gcnew ArgumentNullException("stream");
+
+    ExportEntry^ entry = Export(key);
+
+    if (!entry)
+        throw Context->ConstructException("Export failed");
+
+    stream->Write(entry->Utf8, 0, entry->Utf8->Length);
+}
+
+bool ProjObject::ExportTryWrite(int key, IntPtr buffer, int bufferSize, int% bytesWritten)
+{
+    if (bufferSize < 0)
+        throw gcnew ArgumentOutOfRangeException("bufferSize");
+    else if (buffer == IntPtr::Zero && bufferSize > 0)
+        throw gcnew ArgumentNullException("buffer");
+
+    ExportEntry^ entry = Export(key);
+
+    if (!entry)
+        throw Context->ConstructException("Export failed");
+
+    bytesWritten = entry->Utf8->Length;
+
+    if (entry->Utf8->Length > bufferSize)
+        return false;
+
+    System::Runtime::InteropServices::Marshal::Copy(entry->Utf8, 0, buffer, entry->Utf8->Length);
+    return true;
+}
+
+String^ ProjObject::AsProjJson(ProjJsonOptions^ options)
+{
+    return ExportText(projjson_key(options));
+}
+
+String^ ProjObject::AsWellKnownText(WktOptions^ options)
+{
+    return ExportText(wkt_key(options));
+}
+
+String^ ProjObject::AsProjString(ProjStringOptions^ options)
+{
+    return ExportText(projstring_key(options));
+}
+
+void ProjObject::WriteProjJson(System::IO::Stream^ stream, ProjJsonOptions^ options)
+{
+    ExportWrite(projjson_key(options), stream);
+}
+
+void ProjObject::WriteWellKnownText(System::IO::Stream^ stream, WktOptions^ options)
+{
+    ExportWrite(wkt_key(options), stream);
+}
+
+void ProjObject::WriteProjString(System::IO::Stream^ stream, ProjStringOptions^ options)
+{
+    ExportWrite(projstring_key(options), stream);
+}
+
+bool ProjObject::TryWriteProjJson(IntPtr buffer, int bufferSize, int% bytesWritten, ProjJsonOptions^ options)
+{
+    return ExportTryWrite(projjson_key(options), buffer, bufferSize, bytesWritten);
+}
+
+bool ProjObject::TryWriteWellKnownText(IntPtr buffer, int bufferSize, int% bytesWritten, WktOptions^ options)
+{
+    return ExportTryWrite(wkt_key(options), buffer, bufferSize, bytesWritten);
+}
+
+bool ProjObject::TryWriteProjString(IntPtr buffer, int bufferSize, int% bytesWritten, ProjStringOptions^ options)
+{
+    return ExportTryWrite(projstring_key(options), buffer, bufferSize, bytesWritten);
+}
+
 
 ProjObject^ ProjContext::Create(String^ definition)
 {
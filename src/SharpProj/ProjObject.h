@@ -6,6 +6,7 @@
 #include "PPoint.h"
 #include "UsageArea.h"
 #include "ProjIdentifier.h"
+#include "ProjFingerprint.h"
 
 namespace SharpProj {
     using System::Collections::Generic::IReadOnlyList;
@@ -154,6 +155,13 @@ namespace SharpProj {
         public ref class ProjObject
         {
         private:
+            ref class ExportEntry sealed
+            {
+            public:
+                array<Byte>^ Utf8;
+                String^ Text;
+            };
+
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             ProjContext^ m_ctx;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
@@ -176,6 +184,10 @@ namespace SharpProj {
             bool m_noProj;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             Proj::UsageArea^ m_usageArea;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            ProjFingerprint m_fingerprint;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            System::Collections::Generic::Dictionary<int, ExportEntry^>^ m_exports;
 
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             bool _disposed;
@@ -347,115 +359,62 @@ namespace SharpProj {
                 }
             }
 
-            String^ AsProjJson(ProjJsonOptions^ options)
-            {
-                if (m_noProj)
-                    return nullptr;
-
-                const char* opts[30] = {};
-                int nOpts = 0;
-
-                if (options && options->NoMultiLine)
-                    opts[nOpts++] = "MULTILINE=NO";
-                if (options && options->NoIndentation)
-                    opts[nOpts++] = "INDENTATION_WIDTH=0";
-                if (options && options->ProjJsonType != ProjJsonType::None)
-                {
-                    switch (options->ProjJsonType)
-                    {
-                    case ProjJsonType::SchemaV02:
-                        opts[nOpts++] = "SCHEMA=https://proj.org/schemas/v0.2/projjson.schema.json";
-                        break;
-                    case ProjJsonType::SchemaV04:
-                        opts[nOpts++] = "SCHEMA=https://proj.org/schemas/v0.4/projjson.schema.json";
-                        break;
-                    default:
-                        throw gcnew ArgumentOutOfRangeException();
-                    }
-                }
-
-                const char* v = proj_as_projjson(Context, this, opts);
-
-                return Utf8_PtrToString(v);
-            }
+            String^ AsProjJson(ProjJsonOptions^ options);
 
             String^ AsProjJson()
             {
                 return AsProjJson(nullptr);
             }
 
-            String^ AsWellKnownText(WktOptions^ options)
-            {
-                if (m_noProj)
-                    return nullptr;
-                PJ_WKT_TYPE tp = options ? (PJ_WKT_TYPE)options->WktType : PJ_WKT2_2019;
-                const char* opts[30] = {};
-                int nOpts = 0;
-
-                if (options && (tp != PJ_WKT1_ESRI) == options->SingleLine)
-                {
-                    opts[nOpts++] = (tp != PJ_WKT1_ESRI) ? "MULTILINE=NO" : "MULTILINE=YES";
-                }
-                if (options && options->NoIndentation)
-                {
-                    opts[nOpts++] = "INDENTATION_WIDTH=0";
-                }
-                if (options && options->WriteAxis.HasValue)
-                {
-                    opts[nOpts++] = options->WriteAxis.Value ? "OUTPUT_AXIS=YES" : "OUTPUT_AXIS=NO";
-                }
-                if (!options || !options->Strict)
-                {
-                    opts[nOpts++] = "STRICT=NO";
-                }
-                if (options && options->AllowEllipsoidalHeightAsVerticalCRS)
-                {
-                    opts[nOpts++] = "ALLOW_ELLIPSOIDAL_HEIGHT_AS_VERTICAL_CRS=YES";
-                }
-
-                const char* v = proj_as_wkt(Context, this, tp, opts);
-
-                return Utf8_PtrToString(v);
-            }
+            String^ AsWellKnownText(WktOptions^ options);
 
             String^ AsWellKnownText()
             {
                 return AsWellKnownText(nullptr);
             }
 
-            String^ AsProjString(ProjStringOptions^ options)
-            {
-                if (m_noProj)
-                    return nullptr;
-
-                PJ_PROJ_STRING_TYPE string_type = options ? (PJ_PROJ_STRING_TYPE)options->ProjStringType : PJ_PROJ_5 /* Last as of 2021-01 */;
-
-                const char* opts[30] = {};
-                int nOpts = 0;
-
-                if (options && options->MultiLine)
-                {
-                    opts[nOpts++] = "MULTILINE=YES";
-                }
-                if (options && options->NoIndentation)
-                {
-                    opts[nOpts++] = "INDENTATION_WIDTH=0";
-                }
-                if (options && options->WriteApproxFlag)
-                {
-                    opts[nOpts++] = "USE_APPROX_TMERC=YES";
-                }
-
-                const char* v = proj_as_proj_string(Context, this, string_type, opts);
-
-                return Utf8_PtrToString(v);
-            }
+            String^ AsProjString(ProjStringOptions^ options);
 
             String^ AsProjString()
             {
                 return AsProjString(nullptr);
             }
 
+            /// <summary>
+            /// Writes the PROJJSON definition of this object as UTF-8 to <paramref name="stream"/>
+            /// </summary>
+            void WriteProjJson(System::IO::Stream^ stream, [Optional] ProjJsonOptions^ options);
+            /// <summary>
+            /// Writes the WKT definition of this object as UTF-8 to <paramref name="stream"/>
+            /// </summary>
+            void WriteWellKnownText(System::IO::Stream^ stream, [Optional] WktOptions^ options);
+            /// <summary>
+            /// Writes the PROJ string definition of this object as UTF-8 to <paramref name="stream"/>
+            /// </summary>
+            void WriteProjString(System::IO::Stream^ stream, [Optional] ProjStringOptions^ options);
+
+            /// <summary>
+            /// Writes the PROJJSON definition of this object as UTF-8 (without terminating 0) to the memory at <paramref name="buffer"/>.
+            /// Returns false when the buffer is too small, in which case <paramref name="bytesWritten"/> is set to the required size
+            /// </summary>
+            bool TryWriteProjJson(IntPtr buffer, int bufferSize, [Out] int% bytesWritten, [Optional] ProjJsonOptions^ options);
+            /// <summary>
+            /// Writes the WKT definition of this object as UTF-8 (without terminating 0) to the memory at <paramref name="buffer"/>.
+            /// Returns false when the buffer is too small, in which case <paramref name="bytesWritten"/> is set to the required size
+            /// </summary>
+            bool TryWriteWellKnownText(IntPtr buffer, int bufferSize, [Out] int% bytesWritten, [Optional] WktOptions^ options);
+            /// <summary>
+            /// Writes the PROJ string definition of this object as UTF-8 (without terminating 0) to the memory at <paramref name="buffer"/>.
+            /// Returns false when the buffer is too small, in which case <paramref name="bytesWritten"/> is set to the required size
+            /// </summary>
+            bool TryWriteProjString(IntPtr buffer, int bufferSize, [Out] int% bytesWritten, [Optional] ProjStringOptions^ options);
+
+        private:
+            ExportEntry^ Export(int key);
+            String^ ExportText(int key);
+            void ExportWrite(int key, System::IO::Stream^ stream);
+            bool ExportTryWrite(int key, IntPtr buffer, int bufferSize, int% bytesWritten);
+
         public:
             /// <summary>
             /// Gets the list of declared identifiers of this proj object. (Most commonly filled from the database or WKT)
@@ -480,6 +439,14 @@ namespace SharpProj {
                 }
             }
 
+            /// <summary>
+            /// Gets the structural fingerprint of this object. Calculated once, on first use
+            /// </summary>
+            property ProjFingerprint Fingerprint
+            {
+                ProjFingerprint get();
+            }
+
             /// <summary>
             /// Checks if this Object is equivalent to the other proj object.
             /// </summary>
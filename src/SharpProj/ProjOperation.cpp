@@ -1,10 +1,71 @@
 #include "pch.h"
+#include <vector>
 #include "ProjOperation.h"
 #include "CoordinateTransform.h"
 
+#pragma managed(push, off)
+namespace {
+    struct proj_token
+    {
+        int start;
+        int length;
+        bool quoted;
+    };
+
+    inline bool proj_is_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Splits a PROJ string in its tokens in one pass, without copying any text
+    void proj_tokenize(const char* def, std::vector<proj_token>& tokens)
+    {
+        const char* p = def;
+
+        while (*p)
+        {
+            while (*p && proj_is_space(*p))
+                p++;
+
+            if (!*p)
+                break;
+
+            if (*p == '+' && p[1])
+                p++;
+
+            const char* start = p;
+            bool in_str = false;
+            bool found_str = false;
+
+            while (*p && (in_str || !proj_is_space(*p)))
+            {
+                if (*p == '\"')
+                {
+                    in_str = !in_str;
+                    found_str = true;
+                }
+
+                p++;
+            }
+
+            if (p > start)
+                tokens.push_back(proj_token{ (int)(start - def), (int)(p - start), found_str });
+        }
+    }
+}
+#pragma managed(pop)
+
 IReadOnlyList<ProjOperation^>^ CoordinateTransform::ProjOperations()
 {
-    return gcnew ProjOperationList(this);
+    return OperationList;
+}
+
+ProjOperationList^ CoordinateTransform::OperationList::get()
+{
+    if (!m_projOperations)
+        m_projOperations = gcnew ProjOperationList(this);
+
+    return m_projOperations;
 }
 
 ProjOperationList::ProjOperationList(CoordinateTransform^ transform)
@@ -24,73 +85,121 @@ void ProjOperationList::Ensure()
 
     if (!def)
     {
-        m_tokens = Array::AsReadOnly(EMPTY_ARRAY(String^));
+        m_tokenArray = m_keys = m_values = EMPTY_ARRAY(String^);
+        m_tokens = m_commonTokens = Array::AsReadOnly(m_tokenArray);
         m_items = EMPTY_ARRAY(ProjOperation^);
+        m_transform->Context->ClearError(m_transform);
         return;
     }
-    List<String^>^ tokens = gcnew List<String^>();
 
-    while (*def)
-    {
-        while (*def && Char::IsWhiteSpace(*def))
-            def++;
+    std::vector<proj_token> parsed;
+    proj_tokenize(def, parsed);
 
-        if (!*def)
-            break;
+    int n = (int)parsed.size();
+    array<String^>^ tokens = gcnew array<String^>(n);
+    array<String^>^ keys = gcnew array<String^>(n);
+    array<String^>^ values = gcnew array<String^>(n);
+    int nSteps = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        const proj_token& t = parsed[i];
+        String^ v = Utf8_PtrToString(def + t.start, t.length);
 
-        if (*def == '+' && def[1])
-            def++;
+        if (t.quoted)
+            v = v->Replace(L"\"\"", L"\uFFFD")->Replace(L"\"", L"")->Replace(L"\uFFFD", L"\"");
 
-        const char* start = def;
-        bool in_str = false;
-        bool found_str = false;
+        int eq = v->IndexOf('=');
 
-        while (*def && (in_str || !Char::IsWhiteSpace(*def)))
+        tokens[i] = v;
+        if (eq >= 0)
         {
-            if (*def == '\"')
-            {
-                in_str = !in_str;
-                found_str = true;
-            }
-
-            *def++;
+            keys[i] = v->Substring(0, eq);
+            values[i] = v->Substring(eq + 1);
         }
+        else
+        {
+            keys[i] = v;
 
-        String^ v = Utf8_PtrToString(start, (int)(def - start));
-
-        if (found_str)
-            v = v->Replace(L"\"\"", L"\uFFFD")->Replace(L"\"", L"")->Replace(L"\uFFFD", L"\"");
-
-        tokens->Add(v);
+            if (v == "step")
+                nSteps++;
+        }
     }
 
-    auto tokenArray = tokens->ToArray();
-    m_tokens = Array::AsReadOnly(tokenArray);
+    m_tokenArray = tokens;
+    m_keys = keys;
+    m_values = values;
+    m_tokens = Array::AsReadOnly(tokens);
 
-    if (tokenArray->Length && tokenArray[0] == "proj=pipeline")
+    if (n && tokens[0] == "proj=pipeline")
     {
-        int iStep = Array::IndexOf(tokenArray, "step");
-        m_iCommonStart = 1;
-        m_iCommonCount = iStep - 1;
+        array<ProjOperation^>^ steps = gcnew array<ProjOperation^>(nSteps);
+        int iStep = -1;
+        int nStep = 0;
 
-        List<ProjOperation^>^ steps = gcnew List<ProjOperation^>();
-        int iNext;
-        do
+        for (int i = 1; i < n; i++)
         {
-            iNext = Array::IndexOf(tokenArray, "step", iStep + 1);
+            if (values[i] || keys[i] != "step")
+                continue;
+
+            if (iStep >= 0)
+                steps[nStep++] = gcnew ProjOperation(this, iStep + 1, i - iStep - 1);
+            else
+                m_iCommonCount = i - 1;
 
-            if (iNext < 0)
-                iNext = tokenArray->Length;
+            iStep = i;
+        }
 
-            steps->Add(gcnew ProjOperation(this, iStep + 1, iNext - iStep - 1));
-            iStep = iNext;
-        } while (iNext < tokenArray->Length);
+        m_iCommonStart = 1;
+        if (iStep >= 0)
+            steps[nStep++] = gcnew ProjOperation(this, iStep + 1, n - iStep - 1);
+        else
+            m_iCommonCount = n - 1; // Pipeline without steps
 
-        m_items = steps->ToArray();
+        m_items = steps;
     }
     else
     {
-        m_items = gcnew array<ProjOperation^> { gcnew ProjOperation(this, 0, m_tokens->Count)};
+        m_items = gcnew array<ProjOperation^> { gcnew ProjOperation(this, 0, n) };
+    }
+
+    m_commonTokens = TokenRange(m_iCommonStart, m_iCommonCount);
+}
+
+IReadOnlyList<String^>^ ProjOperationList::TokenRange(int offset, int count)
+{
+    Ensure();
+
+    if (count <= 0)
+        return Array::AsReadOnly(EMPTY_ARRAY(String^));
+
+    array<String^>^ range = gcnew array<String^>(count);
+    Array::Copy(m_tokenArray, offset, range, 0, count);
+
+    return Array::AsReadOnly(range);
+}
+
+bool ProjOperationList::HasToken(int offset, int count, String^ token)
+{
+    Ensure();
+
+    for (int i = offset; i < offset + count; i++)
+    {
+        if (String::Equals(m_tokenArray[i], token))
+            return true;
+    }
+
+    return false;
+}
+
+void ProjOperationList::AddParameters(Dictionary<String^, String^>^ parameters, int offset, int count)
+{
+    Ensure();
+
+    for (int i = offset; i < offset + count; i++)
+    {
+        if (m_values[i] && !parameters->ContainsKey(m_keys[i]))
+            parameters->Add(m_keys[i], m_values[i]);
     }
 }
 
@@ -22,8 +22,16 @@ namespace SharpProj {
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             array<ProjOperation^>^ m_items;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            array<String^>^ m_tokenArray;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            array<String^>^ m_keys; // Parameter name of each token, or the token itself for flags
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            array<String^>^ m_values; // Parameter value of each token, or nullptr for flags
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             IReadOnlyList<String^>^ m_tokens;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            IReadOnlyList<String^>^ m_commonTokens;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             int m_iCommonStart;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             int m_iCommonCount;
@@ -36,19 +44,29 @@ namespace SharpProj {
             {
                 IReadOnlyList<String^>^ get()
                 {
+                    Ensure();
                     return m_tokens;
                 }
             }
 
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
-            property IEnumerable<String^>^ CommonTokens
+            property IReadOnlyList<String^>^ CommonTokens
             {
-                IEnumerable<String^>^ get()
+                IReadOnlyList<String^>^ get()
                 {
-                    return ListRange(Tokens, m_iCommonStart, m_iCommonCount);
+                    Ensure();
+                    return m_commonTokens;
                 }
             }
 
+            IReadOnlyList<String^>^ TokenRange(int offset, int count);
+            bool HasToken(int offset, int count, String^ token);
+            void AddParameters(Dictionary<String^, String^>^ parameters, int offset, int count);
+            void AddCommonParameters(Dictionary<String^, String^>^ parameters)
+            {
+                AddParameters(parameters, m_iCommonStart, m_iCommonCount);
+            }
+
         private:
             virtual System::Collections::IEnumerator^ Obj_GetEnumerator() sealed = System::Collections::IEnumerable::GetEnumerator
             {
@@ -80,15 +98,6 @@ namespace SharpProj {
                             return m_items[index];
                     }
             }
-
-        private:
-            generic<typename T> static IEnumerable<T>^ ListRange(IReadOnlyList<T>^ list, int offset, int count)
-            {
-                if (count <= 0)
-                    return System::Linq::Enumerable::Empty<T>();
-
-                return System::Linq::Enumerable::Take(System::Linq::Enumerable::Skip(list, offset), count);
-            }
         };
 
         public enum class ProjOperationType
@@ -113,6 +122,10 @@ namespace SharpProj {
             String^ m_name;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             ProjOperationType m_type;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            IReadOnlyList<String^>^ m_tokens;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            Dictionary<String^, String^>^ m_parameters;
 
         internal:
             ProjOperation(ProjOperationList^ list, int offset, int count)
@@ -140,7 +153,10 @@ namespace SharpProj {
             {
                 IEnumerable<String^>^ get()
                 {
-                    return ListRange(m_list->Tokens, m_offset, m_count);
+                    if (!m_tokens)
+                        m_tokens = m_list->TokenRange(m_offset, m_count);
+
+                    return m_tokens;
                 }
             }
 
@@ -156,7 +172,7 @@ namespace SharpProj {
             {
                 bool get()
                 {
-                    return System::Linq::Enumerable::Contains(Tokens, (String^)"inv");
+                    return m_list->HasToken(m_offset, m_count, "inv");
                 }
             }
 
@@ -164,7 +180,7 @@ namespace SharpProj {
             {
                 bool get()
                 {
-                    return System::Linq::Enumerable::Contains(Tokens, (String^)"omit_fwd");
+                    return m_list->HasToken(m_offset, m_count, "omit_fwd");
                 }
             }
 
@@ -172,7 +188,7 @@ namespace SharpProj {
             {
                 bool get()
                 {
-                    return System::Linq::Enumerable::Contains(Tokens, (String^)"omit_fwd");
+                    return m_list->HasToken(m_offset, m_count, "omit_inv");
                 }
             }
 
@@ -181,15 +197,6 @@ namespace SharpProj {
                 ProjOperationType get();
             }
 
-        private:
-            generic<typename T> static IEnumerable<T>^ ListRange(IReadOnlyList<T>^ list, int offset, int count)
-            {
-                if (count <= 0)
-                    return System::Linq::Enumerable::Empty<T>();
-
-                return System::Linq::Enumerable::Take(System::Linq::Enumerable::Skip(list, offset), count);
-            }
-
         public:
             virtual String^ ToString() override
             {
@@ -201,13 +208,21 @@ namespace SharpProj {
             {
                 String ^ get(String ^ key)
                 {
-                     key += "=";
-                     for each (String ^ s in AllTokens) // Look in specific tokens + common tokens
-                     {
-                             if (s->StartsWith(key))
-                                     return s->Substring(key->Length);
-                     }
-                     return nullptr;
+                    if (!m_parameters)
+                    {
+                        auto parameters = gcnew Dictionary<String^, String^>();
+
+                        // Specific tokens + common tokens; the first occurrence wins
+                        m_list->AddParameters(parameters, m_offset, m_count);
+                        m_list->AddCommonParameters(parameters);
+                        m_parameters = parameters;
+                    }
+
+                    String^ value;
+                    if (key && m_parameters->TryGetValue(key, value))
+                        return value;
+
+                    return nullptr;
                 }
             }
         };
@@ -1,9 +1,72 @@
 #include "pch.h"
+#include <cmath>
+#include <vector>
 #include "ProjObject.h"
 #include "CoordinateTransform.h"
 #include "GeographicCRS.h"
 #include "UsageArea.h"
 
+using System::Collections::BitArray;
+
+#pragma managed(push, off)
+namespace {
+    // Sets bit i in bits when (lon[i], lat[i]) is inside the area. Longitudes are compared by their distance east of west,
+    // which handles areas crossing the antimeridian and longitudes outside [-180, 180]. NaN and HUGE_VAL never match.
+    void area_contains(const double* lon, const double* lat, int count, double west, double south, double east, double north, int* bits)
+    {
+        double span = east - west;
+
+        if (span < 0)
+            span += 360;
+
+        for (int i = 0; i < count; i++)
+        {
+            double d = lon[i] - west;
+
+            if (!(d >= 0 && d < 360))
+                d -= 360 * std::floor(d / 360);
+
+            if (d <= span && lat[i] >= south && lat[i] <= north)
+                bits[i >> 5] |= (int)(1u << (i & 31));
+        }
+    }
+}
+#pragma managed(pop)
+
+bool ProjArea::Contains(double longitude, double latitude)
+{
+    int bits = 0;
+    area_contains(&longitude, &latitude, 1, WestLongitude, SouthLatitude, EastLongitude, NorthLatitude, &bits);
+
+    return bits != 0;
+}
+
+BitArray^ ProjArea::Contains(array<double>^ longitudes, array<double>^ latitudes)
+{
+    if (!longitudes)
+        throw gcnew ArgumentNullException("longitudes");
+    else if (!latitudes)
+        throw gcnew ArgumentNullException("latitudes");
+    else if (longitudes->Length != latitudes->Length)
+        throw gcnew ArgumentException("Invalid length of latitudes array", "latitudes");
+
+    int count = longitudes->Length;
+    array<int>^ bits = gcnew array<int>((count + 31) / 32);
+
+    if (count)
+    {
+        pin_ptr<double> pLon = &longitudes[0];
+        pin_ptr<double> pLat = &latitudes[0];
+        pin_ptr<int> pBits = &bits[0];
+
+        area_contains(pLon, pLat, count, WestLongitude, SouthLatitude, EastLongitude, NorthLatitude, pBits);
+    }
+
+    BitArray^ result = gcnew BitArray(bits);
+    result->Length = count;
+    return result;
+}
+
 void UsageArea::InternalDispose()
 {
     DisposeIfNotNull(m_latLonTransform);
@@ -32,15 +95,11 @@ CoordinateTransform^ UsageArea::GetLatLonConvert()
 
             if (!m_latLonTransform || !m_latLonTransform->HasInverse)
             {
-                // Ok, then we fall back to the WGS84 definition for the coordinate conversion
-
-                CoordinateReferenceSystem^ wgs84 = CoordinateReferenceSystem::CreateFromEpsg(4326, crs->Context)->WithNormalizedAxis(nullptr);
-                m_latLonTransform = CoordinateTransform::Create(crs, wgs84, crs->Context);
+                // Ok, then we fall back to the WGS84 definition for the coordinate conversion, which is kept by the context
+                m_latLonTransform = CoordinateTransform::Create(crs, crs->Context->Wgs84, crs->Context);
 
                 if (!m_latLonTransform->HasInverse)
                     m_latLonTransform = nullptr;
-
-                delete wgs84;
             }
         }
     }
@@ -48,59 +107,75 @@ CoordinateTransform^ UsageArea::GetLatLonConvert()
     return m_latLonTransform;
 }
 
+// Converts all four corners in a single call. Corners that fail are left unset, so the property getters
+// report the failure exactly like a separate conversion would
+void UsageArea::CalculateCorners()
+{
+    if (m_hasCorners)
+        return;
+
+    m_hasCorners = true;
+
+    CoordinateTransform^ t = GetLatLonConvert();
+
+    if (!t)
+    {
+        m_NW = m_NE = m_SW = m_SE = PPoint(double::NaN, double::NaN);
+        return;
+    }
+
+    double xs[4] = { WestLongitude, EastLongitude, WestLongitude, EastLongitude };
+    double ys[4] = { NorthLatitude, NorthLatitude, SouthLatitude, SouthLatitude };
+
+    t->TransformBoundsPoints(false, xs, ys, 4);
+
+    if (std::isfinite(xs[0]) && std::isfinite(ys[0]))
+        m_NW = PPoint(xs[0], ys[0]);
+    if (std::isfinite(xs[1]) && std::isfinite(ys[1]))
+        m_NE = PPoint(xs[1], ys[1]);
+    if (std::isfinite(xs[2]) && std::isfinite(ys[2]))
+        m_SW = PPoint(xs[2], ys[2]);
+    if (std::isfinite(xs[3]) && std::isfinite(ys[3]))
+        m_SE = PPoint(xs[3], ys[3]);
+}
+
 SharpProj::PPoint UsageArea::NorthWestCorner::get()
 {
+    CalculateCorners();
+
     if (!m_NW.HasValue)
-    {
-        CoordinateTransform^ t = GetLatLonConvert();
+        m_NW = GetLatLonConvert()->ApplyReversed(PPoint(WestLongitude, NorthLatitude));
 
-        if (t)
-            m_NW = t->ApplyReversed(PPoint(WestLongitude, NorthLatitude));
-        else
-            m_NW = PPoint(double::NaN, double::NaN);
-    }
     return m_NW.Value;
 }
 
 SharpProj::PPoint UsageArea::SouthEastCorner::get()
 {
+    CalculateCorners();
+
     if (!m_SE.HasValue)
-    {
-        CoordinateTransform^ t = GetLatLonConvert();
+        m_SE = GetLatLonConvert()->ApplyReversed(PPoint(EastLongitude, SouthLatitude));
 
-        if (t)
-            m_SE = t->ApplyReversed(PPoint(EastLongitude, SouthLatitude));
-        else
-            m_SE = PPoint(double::NaN, double::NaN);
-    }
     return m_SE.Value;
 }
 
 SharpProj::PPoint UsageArea::SouthWestCorner::get()
 {
+    CalculateCorners();
+
     if (!m_SW.HasValue)
-    {
-        CoordinateTransform^ t = GetLatLonConvert();
+        m_SW = GetLatLonConvert()->ApplyReversed(PPoint(WestLongitude, SouthLatitude));
 
-        if (t)
-            m_SW = t->ApplyReversed(PPoint(WestLongitude, SouthLatitude));
-        else
-            m_SW = PPoint(double::NaN, double::NaN);
-    }
     return m_SW.Value;
 }
 
 SharpProj::PPoint UsageArea::NorthEastCorner::get()
 {
+    CalculateCorners();
+
     if (!m_NE.HasValue)
-    {
-        CoordinateTransform^ t = GetLatLonConvert();
+        m_NE = GetLatLonConvert()->ApplyReversed(PPoint(EastLongitude, NorthLatitude));
 
-        if (t)
-            m_NE = t->ApplyReversed(PPoint(EastLongitude, NorthLatitude));
-        else
-            m_NE = PPoint(double::NaN, double::NaN);
-    }
     return m_NE.Value;
 }
 
@@ -178,3 +253,52 @@ double UsageArea::CenterY::get()
     else
         return double::NaN;
 }
+
+bool UsageArea::ContainsCoordinate(PPoint coordinate)
+{
+    return ContainsCoordinates(gcnew array<double> { coordinate.X }, gcnew array<double> { coordinate.Y })[0];
+}
+
+BitArray^ UsageArea::ContainsCoordinates(array<double>^ xValues, array<double>^ yValues)
+{
+    if (!xValues)
+        throw gcnew ArgumentNullException("xValues");
+    else if (!yValues)
+        throw gcnew ArgumentNullException("yValues");
+    else if (xValues->Length != yValues->Length)
+        throw gcnew ArgumentException("Invalid length of yValues array", "yValues");
+
+    int count = xValues->Length;
+    array<int>^ bits = gcnew array<int>((count + 31) / 32);
+    CoordinateTransform^ t = GetLatLonConvert();
+
+    if (count && t)
+    {
+        // Convert in chunks of whole bitmask words, so every chunk starts at a word boundary
+        const int chunk = 65536;
+        std::vector<double> lon(Math::Min(count, chunk));
+        std::vector<double> lat(lon.size());
+
+        pin_ptr<double> pX = &xValues[0];
+        pin_ptr<double> pY = &yValues[0];
+        pin_ptr<int> pBits = &bits[0];
+
+        for (int first = 0; first < count; first += chunk)
+        {
+            int n = Math::Min(chunk, count - first);
+
+            memcpy(lon.data(), pX + first, n * sizeof(double));
+            memcpy(lat.data(), pY + first, n * sizeof(double));
+
+            t->TransformBoundsPoints(true, lon.data(), lat.data(), n);
+
+            area_contains(lon.data(), lat.data(), n, WestLongitude, SouthLatitude, EastLongitude, NorthLatitude, pBits + first / 32);
+        }
+
+        t->Context->ClearError(t);
+    }
+
+    BitArray^ result = gcnew BitArray(bits);
+    result->Length = count;
+    return result;
+}
@@ -29,6 +29,8 @@ namespace SharpProj {
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             bool m_hasMinMax;
             [DebuggerBrowsable(DebuggerBrowsableState::Never)]
+            bool m_hasCorners;
+            [DebuggerBrowsable(DebuggerBrowsableState::Never)]
             CoordinateTransform^ m_latLonTransform;
 
         internal:
@@ -47,6 +49,7 @@ namespace SharpProj {
 
         private:
             CoordinateTransform^ GetLatLonConvert();
+            void CalculateCorners();
             void CalculateBounds();
 
         public:
@@ -136,6 +139,20 @@ namespace SharpProj {
             {
                 double get();
             }
+
+        public:
+            /// <summary>
+            /// Checks whether the coordinate, expressed in the CRS this area belongs to, is inside the area of use
+            /// </summary>
+            bool ContainsCoordinate(PPoint coordinate);
+
+            /// <summary>
+            /// Checks for every coordinate (xValues[i], yValues[i]), expressed in the CRS this area belongs to, whether it is inside the
+            /// area of use. The coordinates are converted to latitude and longitude in one batch, coordinates that can't be converted
+            /// are reported as outside.
+            /// </summary>
+            /// <returns>A bitmask with a bit set for every coordinate inside the area</returns>
+            System::Collections::BitArray^ ContainsCoordinates(array<double>^ xValues, array<double>^ yValues);
         };
     }
 }
\ No newline at end of file